@@ -0,0 +1,64 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Minimal Arduino API for host builds
+ *
+ *  Provides the subset of the Arduino API used by the library so that it
+ *  can be built and run on a host against the mock transport.
+ *  Pins are simulated by host_arduino.h.
+ *
+ */
+
+#ifndef ARDUINO_H
+#define ARDUINO_H
+
+#include <stdint.h>
+#include <stdbool.h>
+#include <stddef.h>
+#include <string.h>
+#include <math.h>
+
+#define HIGH                           1
+#define LOW                            0
+#define INPUT                          0
+#define OUTPUT                         1
+#define RISING                         3
+#define MSBFIRST                       1
+#define SPI_MODE1                      1
+
+void pinMode(int pin, int mode);
+void digitalWrite(int pin, int val);
+int digitalRead(int pin);
+uint32_t millis(void);
+uint32_t micros(void);
+void delay(uint32_t ms);
+void delayMicroseconds(uint32_t us);
+void attachInterrupt(int pin, void (*handler)(void), int mode);
+void detachInterrupt(int pin);
+int digitalPinToInterrupt(int pin);
+void noInterrupts(void);
+void interrupts(void);
+
+#endif /* ARDUINO_H */
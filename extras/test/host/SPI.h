@@ -0,0 +1,71 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Minimal SPIClass for host builds, the bus is never driven
+ *
+ */
+
+#ifndef SPI_H
+#define SPI_H
+
+#include "Arduino.h"
+
+class SPISettings {
+  public:
+    SPISettings(void) {}
+    SPISettings(uint32_t clock, uint8_t bitOrder, uint8_t dataMode)
+    {
+      (void)clock;
+      (void)bitOrder;
+      (void)dataMode;
+    }
+};
+
+class SPIClass {
+  public:
+    void beginTransaction(SPISettings settings)
+    {
+      (void)settings;
+    }
+    void endTransaction(void) {}
+    uint8_t transfer(uint8_t data)
+    {
+      (void)data;
+      return 0U;
+    }
+    void transfer(void *buf, size_t count)
+    {
+      memset(buf, 0, count);
+    }
+    void transfer(const void *txBuf, void *rxBuf, size_t count)
+    {
+      (void)txBuf;
+      if (rxBuf != NULL) {
+        memset(rxBuf, 0, count);
+      }
+    }
+};
+
+#endif /* SPI_H */
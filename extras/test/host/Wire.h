@@ -0,0 +1,76 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Minimal TwoWire for host builds, the bus is never driven
+ *
+ */
+
+#ifndef WIRE_H
+#define WIRE_H
+
+#include "Arduino.h"
+
+class TwoWire {
+  public:
+    void beginTransmission(uint8_t addr)
+    {
+      (void)addr;
+    }
+    uint8_t endTransmission(bool stop = true)
+    {
+      (void)stop;
+      return 0U;
+    }
+    size_t write(uint8_t data)
+    {
+      (void)data;
+      return 1U;
+    }
+    size_t write(const uint8_t *data, size_t len)
+    {
+      (void)data;
+      return len;
+    }
+    uint8_t requestFrom(uint8_t addr, uint8_t len, uint8_t stop = 1U)
+    {
+      (void)addr;
+      (void)stop;
+      return len;
+    }
+    int available(void)
+    {
+      return 0;
+    }
+    int read(void)
+    {
+      return 0;
+    }
+    void setClock(uint32_t clock)
+    {
+      (void)clock;
+    }
+};
+
+#endif /* WIRE_H */
@@ -0,0 +1,145 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Host implementation of the Arduino API used by the library
+ *
+ */
+
+#include <chrono>
+#include <map>
+#include <thread>
+#include "host_arduino.h"
+
+static std::map<int, int>               hostPinLevel;
+static std::map<int, void (*)(void)>    hostPinHandler;
+static hostPinReader                    hostReader = NULL;
+static const std::chrono::steady_clock::time_point hostStart = std::chrono::steady_clock::now();
+
+
+void pinMode(int pin, int mode)
+{
+  (void)pin;
+  (void)mode;
+}
+
+
+void digitalWrite(int pin, int val)
+{
+  hostPinLevel[pin] = val;
+}
+
+
+int digitalRead(int pin)
+{
+  int level;
+
+  if (hostReader != NULL) {
+    level = hostReader(pin);
+    if (level >= 0) {
+      return level;
+    }
+  }
+  return hostPinLevel[pin];
+}
+
+
+uint32_t micros(void)
+{
+  return (uint32_t)std::chrono::duration_cast<std::chrono::microseconds>(std::chrono::steady_clock::now() - hostStart).count();
+}
+
+
+uint32_t millis(void)
+{
+  return (micros() / 1000U);
+}
+
+
+void delay(uint32_t ms)
+{
+  std::this_thread::sleep_for(std::chrono::milliseconds(ms));
+}
+
+
+void delayMicroseconds(uint32_t us)
+{
+  std::this_thread::sleep_for(std::chrono::microseconds(us));
+}
+
+
+void attachInterrupt(int pin, void (*handler)(void), int mode)
+{
+  (void)mode;
+  hostPinHandler[pin] = handler;
+}
+
+
+void detachInterrupt(int pin)
+{
+  hostPinHandler.erase(pin);
+}
+
+
+int digitalPinToInterrupt(int pin)
+{
+  return pin;
+}
+
+
+void noInterrupts(void)
+{
+}
+
+
+void interrupts(void)
+{
+}
+
+
+void hostSetPinReader(hostPinReader reader)
+{
+  hostReader = reader;
+}
+
+
+bool hostIrq(int pin)
+{
+  std::map<int, void (*)(void)>::const_iterator it = hostPinHandler.find(pin);
+
+  if ((it == hostPinHandler.end()) || (it->second == NULL)) {
+    return false;
+  }
+
+  it->second();
+  return true;
+}
+
+
+void (*hostGetIrqHandler(int pin))(void)
+{
+  std::map<int, void (*)(void)>::const_iterator it = hostPinHandler.find(pin);
+
+  return ((it == hostPinHandler.end()) ? NULL : it->second);
+}
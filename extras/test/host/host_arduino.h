@@ -0,0 +1,47 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Pin simulation of the host Arduino API
+ *
+ *  digitalRead() returns the level set by digitalWrite(), unless a pin
+ *  reader is installed, e.g. to derive the IRQ line of a mock chip from
+ *  its IRQ registers. hostIrq() runs the handler attached to a pin as the
+ *  rising edge would.
+ *
+ */
+
+#ifndef HOST_ARDUINO_H
+#define HOST_ARDUINO_H
+
+#include "Arduino.h"
+
+/*! Pin reader: returns the level of \a pin, or -1 to use the level set by digitalWrite() */
+typedef int (*hostPinReader)(int pin);
+
+void hostSetPinReader(hostPinReader reader);
+bool hostIrq(int pin);
+void (*hostGetIrqHandler(int pin))(void);
+
+#endif /* HOST_ARDUINO_H */
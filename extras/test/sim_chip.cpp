@@ -0,0 +1,250 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Simulated ST25R200 and tag on top of the mock transport
+ *
+ */
+
+#include "sim_chip.h"
+#include "host_arduino.h"
+
+uint32_t SimChip::simTimeUs = 0U;
+SimChip  *SimChip::chips[SIM_CHIP_MAX];
+
+
+SimChip::SimChip(int pin) : pin(pin), tagPresent(false), tagLatencyUs(0U), tagRespLen(0U), frames(0U), frameLen(0U), nrtUs(0U)
+{
+  uint8_t i;
+
+  ST_MEMSET(evt, 0x00, sizeof(evt));
+
+  for (i = 0; i < SIM_CHIP_MAX; i++) {
+    if (chips[i] == NULL) {
+      chips[i] = this;
+      break;
+    }
+  }
+
+  hostSetPinReader(pinReader);
+}
+
+
+SimChip::~SimChip()
+{
+  uint8_t i;
+
+  for (i = 0; i < SIM_CHIP_MAX; i++) {
+    if (chips[i] == this) {
+      chips[i] = NULL;
+    }
+  }
+}
+
+
+uint32_t SimChip::time(void)
+{
+  simTimeUs++;
+  return simTimeUs;
+}
+
+
+void SimChip::run(uint32_t us)
+{
+  uint8_t i;
+
+  simTimeUs += us;
+
+  for (i = 0; i < SIM_CHIP_MAX; i++) {
+    if (chips[i] != NULL) {
+      chips[i]->deliver();
+    }
+  }
+}
+
+
+void SimChip::raise(uint32_t irqs)
+{
+  regs[ST25R200_REG_IRQ1] |= (uint8_t)(irqs & 0xFFU);
+  regs[ST25R200_REG_IRQ2] |= (uint8_t)((irqs >> 8U) & 0xFFU);
+  regs[ST25R200_REG_IRQ3] |= (uint8_t)((irqs >> 16U) & 0xFFU);
+
+  hostIrq(pin);
+}
+
+
+void SimChip::setTag(bool present, uint32_t latencyUs, const uint8_t *resp, uint16_t respLen)
+{
+  tagPresent   = present;
+  tagLatencyUs = latencyUs;
+  tagRespLen   = MIN(respLen, (uint16_t)SIM_CHIP_RESP_MAX);
+
+  ST_MEMSET(tagResp, 0x00, sizeof(tagResp));
+  if (resp != NULL) {
+    ST_MEMCPY(tagResp, resp, tagRespLen);
+  }
+}
+
+
+uint32_t SimChip::getFrames(void) const
+{
+  return frames;
+}
+
+
+uint32_t SimChip::getNrtUs(void) const
+{
+  return nrtUs;
+}
+
+
+uint16_t SimChip::getFrameLen(void) const
+{
+  return frameLen;
+}
+
+
+ReturnCode SimChip::xfer(const uint8_t *hdr, uint8_t hdrLen, const uint8_t *txData, uint8_t *rxData, uint16_t length)
+{
+  ReturnCode ret;
+  uint8_t    reg;
+  uint8_t    i;
+
+  ret = ST25R200MockTransport::xfer(hdr, hdrLen, txData, rxData, length);
+  if ((ret != ERR_NONE) || (hdrLen != 1U)) {
+    return ret;
+  }
+
+  if ((hdr[0] & ST25R200_CMD_MASK) == ST25R200_CMD_MASK) {
+    if (hdr[0] == ST25R200_CMD_SET_DEFAULT) {
+      /* Oscillator and regulators come up stable */
+      regs[ST25R200_REG_DISPLAY1] = (ST25R200_REG_DISPLAY1_osc_ok | ST25R200_REG_DISPLAY1_agd_ok);
+      ST_MEMSET(evt, 0x00, sizeof(evt));
+    } else if (hdr[0] == ST25R200_CMD_STOP) {
+      ST_MEMSET(evt, 0x00, sizeof(evt));
+    } else if (hdr[0] == ST25R200_CMD_TRANSMIT) {
+      transmit();
+    } else {
+      /* Other commands complete silently */
+    }
+    return ERR_NONE;
+  }
+
+  /* IRQ registers are cleared on read */
+  reg = (hdr[0] & ST25R200_ADDR_MASK);
+  if ((txData == NULL) && ((hdr[0] & ST25R200_READ_MODE) != 0U) && (reg <= ST25R200_REG_IC_ID)) {
+    for (i = ST25R200_REG_IRQ1; i <= ST25R200_REG_IRQ3; i++) {
+      if ((i >= reg) && (i < ((uint16_t)reg + length))) {
+        regs[i] = 0U;
+      }
+    }
+  }
+
+  return ERR_NONE;
+}
+
+
+void SimChip::transmit(void)
+{
+  uint16_t len;
+  uint32_t txe;
+  uint32_t nrt;
+
+  len = fifoFetch(NULL, ST25R200_FIFO_DEPTH);
+  frames++;
+  frameLen = len;
+
+  /* No-response timer started at the end of transmission */
+  nrt   = (((uint32_t)regs[ST25R200_REG_NRT1] << 8U) | regs[ST25R200_REG_NRT2]);
+  nrt  *= (((regs[ST25R200_REG_NRT_GPT_CONF] & ST25R200_REG_NRT_GPT_CONF_nrt_step) != 0U) ? 4096U : 64U);
+  nrtUs = rfalConv1fcToUs(nrt);
+
+  txe = (simTimeUs + (len * SIM_CHIP_TX_BYTE_US));
+  schedule(txe, ST25R200_IRQ_MASK_TXE);
+
+  if (tagPresent && ((nrtUs == 0U) || (tagLatencyUs < nrtUs))) {
+    schedule((txe + tagLatencyUs), ST25R200_IRQ_MASK_RXS);
+    schedule((txe + tagLatencyUs + ((tagRespLen + RFAL_CRC_LEN) * SIM_CHIP_RX_BYTE_US)), ST25R200_IRQ_MASK_RXE);
+  } else if (nrtUs != 0U) {
+    schedule((txe + nrtUs), ST25R200_IRQ_MASK_NRE);
+  } else {
+    /* Waiting forever */
+  }
+}
+
+
+void SimChip::schedule(uint32_t at, uint32_t irqs)
+{
+  uint8_t i;
+
+  for (i = 0; i < SIM_CHIP_EVT_MAX; i++) {
+    if (!evt[i].pending) {
+      evt[i].pending = true;
+      evt[i].at      = at;
+      evt[i].irqs    = irqs;
+      return;
+    }
+  }
+}
+
+
+void SimChip::deliver(void)
+{
+  uint8_t i;
+  uint8_t next;
+
+  /* Deliver the due events in time order */
+  for (;;) {
+    next = SIM_CHIP_EVT_MAX;
+    for (i = 0; i < SIM_CHIP_EVT_MAX; i++) {
+      if (evt[i].pending && ((int32_t)(simTimeUs - evt[i].at) >= 0) && ((next == SIM_CHIP_EVT_MAX) || ((int32_t)(evt[i].at - evt[next].at) < 0))) {
+        next = i;
+      }
+    }
+
+    if (next == SIM_CHIP_EVT_MAX) {
+      return;
+    }
+
+    evt[next].pending = false;
+    if ((evt[next].irqs & ST25R200_IRQ_MASK_RXE) != 0U) {
+      fifoLoad(tagResp, (uint16_t)(tagRespLen + RFAL_CRC_LEN));
+    }
+    raise(evt[next].irqs);
+  }
+}
+
+
+int SimChip::pinReader(int pin)
+{
+  uint8_t i;
+
+  for (i = 0; i < SIM_CHIP_MAX; i++) {
+    if ((chips[i] != NULL) && (chips[i]->pin == pin)) {
+      return ((chips[i]->getRegister(ST25R200_REG_IRQ1) | chips[i]->getRegister(ST25R200_REG_IRQ2) | chips[i]->getRegister(ST25R200_REG_IRQ3)) != 0U) ? HIGH : LOW;
+    }
+  }
+
+  return -1;
+}
@@ -0,0 +1,104 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Simulated ST25R200 and tag on top of the mock transport
+ *
+ *  Adds to the mock transport what the transceive state machine needs:
+ *  IRQ registers cleared on read and driving the interrupt pin, TXE at
+ *  the end of a transmission, then either the response of a simulated
+ *  tag after a configurable latency (RXS, RXE) or NRE once the programmed
+ *  no-response timer expires.
+ *
+ *  Time is virtual: SimChip::time() is installed as the SW timer time
+ *  source and advances by 1us per read, SimChip::run() advances it and
+ *  delivers the interrupts that became due through the attached handler.
+ *
+ */
+
+#ifndef SIM_CHIP_H
+#define SIM_CHIP_H
+
+#include "rfal_rfst25r200.h"
+
+#define SIM_CHIP_MAX                   8U       /*!< Simulated chips alive at the same time       */
+#define SIM_CHIP_EVT_MAX               4U       /*!< Pending interrupt events per chip            */
+#define SIM_CHIP_RESP_MAX              32U      /*!< Max response length of the simulated tag     */
+#define SIM_CHIP_TX_BYTE_US            10U      /*!< Transmission time per byte                   */
+#define SIM_CHIP_RX_BYTE_US            10U      /*!< Reception time per byte                      */
+
+/*! Interrupt due at a given time, the tag response is loaded with RXE */
+typedef struct {
+  bool     pending;
+  uint32_t at;
+  uint32_t irqs;
+} SimChipEvt;
+
+class SimChip : public ST25R200MockTransport {
+  public:
+    explicit SimChip(int pin);
+    ~SimChip();
+
+    /*! Time source of the SW timers, advances by 1us per read */
+    static uint32_t time(void);
+
+    /*! Advance the time by \a us and deliver the interrupts that became due */
+    static void run(uint32_t us);
+
+    /*! Latch \a irqs and run the interrupt handler of the pin */
+    void raise(uint32_t irqs);
+
+    /*! Tag answering \a resp (CRC appended) \a latencyUs after TXE, or no tag */
+    void setTag(bool present, uint32_t latencyUs, const uint8_t *resp, uint16_t respLen);
+
+    /*! Frames transmitted */
+    uint32_t getFrames(void) const;
+
+    /*! No-response time programmed for the last frame in us, 0 if disabled */
+    uint32_t getNrtUs(void) const;
+    /*! Bytes transmitted with the last frame */
+    uint16_t getFrameLen(void) const;
+
+  protected:
+    ReturnCode xfer(const uint8_t *hdr, uint8_t hdrLen, const uint8_t *txData, uint8_t *rxData, uint16_t length);
+    void transmit(void);
+    void schedule(uint32_t at, uint32_t irqs);
+    void deliver(void);
+    static int pinReader(int pin);
+
+    int        pin;
+    bool       tagPresent;
+    uint32_t   tagLatencyUs;
+    uint8_t    tagResp[SIM_CHIP_RESP_MAX + RFAL_CRC_LEN];
+    uint16_t   tagRespLen;
+    uint32_t   frames;
+    uint16_t   frameLen;
+    uint32_t   nrtUs;
+    SimChipEvt evt[SIM_CHIP_EVT_MAX];
+
+    static uint32_t simTimeUs;
+    static SimChip  *chips[SIM_CHIP_MAX];
+};
+
+#endif /* SIM_CHIP_H */
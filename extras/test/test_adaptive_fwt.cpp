@@ -0,0 +1,148 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Adaptive FWT against a simulated tag with configurable latency
+ *
+ */
+
+#include "sim_chip.h"
+#include "test_common.h"
+
+#define TEST_INT_PIN                   3
+#define TEST_FWT_US                    5000U                          /*!< FWT given by the caller           */
+#define TEST_LATENCY_US                300U                           /*!< Response time of the tag          */
+#define TEST_SLOW_LATENCY_US           1500U                          /*!< Response time of a slower tag     */
+#define TEST_WORKER_STEP_US            5U                             /*!< Time elapsing between worker runs */
+
+static const uint8_t testReq[]  = { 0x30U, 0x00U };
+static const uint8_t testResp[] = { 0x04U, 0x00U };
+
+/*! Run a transceive to completion, return its status and duration */
+static ReturnCode testTransceive(RfalRfST25R200Class &rf, uint32_t *durationUs)
+{
+  rfalTransceiveContext ctx;
+  uint8_t               rx[8];
+  uint16_t              rcvdLen;
+  uint32_t              start;
+  uint32_t              loops;
+  ReturnCode            ret;
+
+  rfalCreateByteFlagsTxRxContext(ctx, testReq, sizeof(testReq), rx, sizeof(rx), &rcvdLen, RFAL_TXRX_FLAGS_DEFAULT, rfalConvUsTo1fc(TEST_FWT_US));
+
+  start = SimChip::time();
+  ret   = rf.rfalStartTransceive(&ctx);
+  if (ret != ERR_NONE) {
+    return ret;
+  }
+
+  for (loops = 0; loops < 100000U; loops++) {
+    SimChip::run(TEST_WORKER_STEP_US);
+    rf.rfalWorker();
+    ret = rf.rfalGetTransceiveStatus();
+    if (ret != ERR_BUSY) {
+      break;
+    }
+  }
+
+  *durationUs = (SimChip::time() - start);
+
+  if ((ret == ERR_NONE) && ((rcvdLen != rfalConvBytesToBits(sizeof(testResp))) || (memcmp(rx, testResp, sizeof(testResp)) != 0))) {
+    return ERR_IO;
+  }
+  return ret;
+}
+
+int main(void)
+{
+  SimChip             chip(TEST_INT_PIN);
+  RfalRfST25R200Class rf(&chip, TEST_INT_PIN);
+  uint32_t            dur;
+  uint32_t            frames;
+  uint32_t            learned;
+  uint32_t            shrunkNrtUs;
+  uint8_t             i;
+
+  rf.timerSetTimeSource(SimChip::time);
+
+  CHECK(rf.rfalInitialize() == ERR_NONE);
+  CHECK(rf.rfalSetMode(RFAL_MODE_POLL_NFCA, RFAL_BR_106, RFAL_BR_106) == ERR_NONE);
+  CHECK(rf.rfalFieldOnAndStartGT() == ERR_NONE);
+  rf.rfalAdaptiveFwtEnable(true);
+
+  chip.setTag(true, TEST_LATENCY_US, testResp, sizeof(testResp));
+
+  /* The given FWT is used until enough responses are learned */
+  for (i = 0; i < RFAL_AFWT_MIN_SAMPLES; i++) {
+    CHECK(testTransceive(rf, &dur) == ERR_NONE);
+    CHECK(chip.getNrtUs() >= TEST_FWT_US);
+  }
+
+  /* The learned response time is the time from TXE to RXS */
+  learned = rf.rfalAdaptiveFwtGet(RFAL_MODE_POLL_NFCA, 0U);
+  CHECK((learned >= rfalConvUsTo1fc(TEST_LATENCY_US)) && (learned <= rfalConvUsTo1fc(TEST_LATENCY_US + 20U)));
+
+  /* Then the FWT is shrunk, the tag still answers in time */
+  CHECK(testTransceive(rf, &dur) == ERR_NONE);
+  shrunkNrtUs = chip.getNrtUs();
+  CHECK((shrunkNrtUs > TEST_LATENCY_US) && (shrunkNrtUs < (TEST_FWT_US / 2U)));
+
+  /* A missing tag times out after the shrunk FWT, with a single frame sent */
+  chip.setTag(false, 0U, NULL, 0U);
+  frames = chip.getFrames();
+  CHECK(testTransceive(rf, &dur) == ERR_TIMEOUT);
+  CHECK(chip.getFrames() == (frames + 1U));
+  CHECK(dur < (TEST_FWT_US / 2U));
+
+  /* The timeout drops the learned responses: back to the given FWT */
+  frames = chip.getFrames();
+  CHECK(testTransceive(rf, &dur) == ERR_TIMEOUT);
+  CHECK(chip.getFrames() == (frames + 1U));
+  CHECK(chip.getNrtUs() >= TEST_FWT_US);
+  CHECK(dur >= TEST_FWT_US);
+
+  /* A slower tag is answered with the given FWT and learned again */
+  chip.setTag(true, TEST_SLOW_LATENCY_US, testResp, sizeof(testResp));
+  for (i = 0; i < RFAL_AFWT_MIN_SAMPLES; i++) {
+    CHECK(testTransceive(rf, &dur) == ERR_NONE);
+    CHECK(chip.getNrtUs() >= TEST_FWT_US);
+  }
+  CHECK(testTransceive(rf, &dur) == ERR_NONE);
+  CHECK((chip.getNrtUs() > TEST_SLOW_LATENCY_US) && (chip.getNrtUs() < TEST_FWT_US));
+
+  /* A tag getting slower than learned times out once, then the given FWT is used */
+  rf.rfalAdaptiveFwtReset();
+  chip.setTag(true, TEST_LATENCY_US, testResp, sizeof(testResp));
+  for (i = 0; i <= RFAL_AFWT_MIN_SAMPLES; i++) {
+    CHECK(testTransceive(rf, &dur) == ERR_NONE);
+  }
+  chip.setTag(true, TEST_SLOW_LATENCY_US, testResp, sizeof(testResp));
+  CHECK(testTransceive(rf, &dur) == ERR_TIMEOUT);
+  CHECK(testTransceive(rf, &dur) == ERR_NONE);
+  CHECK(chip.getNrtUs() >= TEST_FWT_US);
+
+  printf("tag latency %uus: given FWT %uus, shrunk NRT %uus\n", TEST_LATENCY_US, TEST_FWT_US, shrunkNrtUs);
+
+  return TEST_RESULT();
+}
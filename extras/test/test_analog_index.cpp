@@ -0,0 +1,228 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *  \brief Analog Configuration lookup: indexed against linear search
+ *
+ */
+
+#include <chrono>
+
+#include "sim_chip.h"
+#include "test_common.h"
+
+#define TEST_INT_PIN                   8
+#define TEST_ENTRY_LEN                 (sizeof(rfalAnalogConfigId) + sizeof(rfalAnalogConfigNum) + sizeof(rfalAnalogConfigRegAddrMaskVal)) /*!< Generated entry: ID, one register set */
+#define TEST_MAX_MATCHES               16U       /*!< Matches recorded per searched ID                    */
+#define TEST_MAX_QUERIES               (8U * RFAL_ANALOG_CONFIG_LUT_SIZE) /*!< IDs searched             */
+#define TEST_BENCH_ROUNDS              500U      /*!< Passes over the searched IDs per table size          */
+
+/*! RFAL exposing the Analog Configuration search and the table in use */
+class IndexRfal : public RfalRfST25R200Class {
+  public:
+    explicit IndexRfal(ST25R200Transport *transport) : RfalRfST25R200Class(transport, TEST_INT_PIN), fullSize(0U) {}
+
+    /*! Search every Configuration Set of \a id as rfalSetAnalogConfig() does, return their number */
+    uint16_t searchAll(rfalAnalogConfigId id, bool indexed, uint16_t *offsets)
+    {
+      rfalAnalogConfigNum num;
+      uint16_t            offset = 0U;
+      uint16_t            cnt    = 0U;
+      bool                built  = gRfalAnalogConfigMgmt.idx.valid;
+
+      gRfalAnalogConfigMgmt.idx.valid = (built && indexed);
+      while ((num = rfalAnalogConfigSearch(id, &offset)) != RFAL_ANALOG_CONFIG_LUT_NOT_FOUND) {
+        if (cnt < TEST_MAX_MATCHES) {
+          offsets[cnt] = offset;
+        }
+        cnt++;
+        offset += (uint16_t)(num * sizeof(rfalAnalogConfigRegAddrMaskVal));
+      }
+      gRfalAnalogConfigMgmt.idx.valid = built;
+      return cnt;
+    }
+
+    /*! Put \a tbl in use and index it */
+    void load(const uint8_t *tbl, uint16_t size)
+    {
+      gRfalAnalogConfigMgmt.currentAnalogConfigTbl = tbl;
+      gRfalAnalogConfigMgmt.configTblSize          = size;
+      fullSize = size;
+      rfalAnalogConfigIndexBuild();
+    }
+
+    /*! Keep the first \a ids Configuration IDs of the loaded table, 0 for all of them, and index them */
+    uint16_t truncate(uint16_t ids)
+    {
+      const uint8_t *tbl = gRfalAnalogConfigMgmt.currentAnalogConfigTbl;
+      uint16_t      i    = 0U;
+      uint16_t      n    = 0U;
+
+      while ((i < fullSize) && ((ids == 0U) || (n < ids))) {
+        i += (uint16_t)(sizeof(rfalAnalogConfigId) + sizeof(rfalAnalogConfigNum) + (tbl[i + sizeof(rfalAnalogConfigId)] * sizeof(rfalAnalogConfigRegAddrMaskVal)));
+        n++;
+      }
+      gRfalAnalogConfigMgmt.configTblSize = i;
+      rfalAnalogConfigIndexBuild();
+      return n;
+    }
+
+    /*! Append to \a ids those of the table in use, each also with every direction, return their number */
+    uint16_t queries(rfalAnalogConfigId *ids, uint16_t n)
+    {
+      static const uint16_t dirs[] = { RFAL_ANALOG_CONFIG_NO_DIRECTION, RFAL_ANALOG_CONFIG_TX, RFAL_ANALOG_CONFIG_RX,
+                                       RFAL_ANALOG_CONFIG_DPO, RFAL_ANALOG_CONFIG_DLMA
+                                     };
+      const uint8_t      *tbl = gRfalAnalogConfigMgmt.currentAnalogConfigTbl;
+      rfalAnalogConfigId id;
+      uint16_t           i = 0U;
+      uint8_t            d;
+
+      while ((i < gRfalAnalogConfigMgmt.configTblSize) && ((n + SIZEOF_ARRAY(dirs) + 1U) <= TEST_MAX_QUERIES)) {
+        id = GETU16(&tbl[i]);
+
+        ids[n++] = id;
+        for (d = 0U; d < SIZEOF_ARRAY(dirs); d++) {
+          ids[n++] = (rfalAnalogConfigId)((id & ~RFAL_ANALOG_CONFIG_DIRECTION_MASK) | dirs[d]);
+        }
+        i += (uint16_t)(sizeof(rfalAnalogConfigId) + sizeof(rfalAnalogConfigNum) + (tbl[i + sizeof(rfalAnalogConfigId)] * sizeof(rfalAnalogConfigRegAddrMaskVal)));
+      }
+      return n;
+    }
+
+    bool indexValid(void)
+    {
+      return gRfalAnalogConfigMgmt.idx.valid;
+    }
+
+    uint16_t fullSize;
+};
+
+/*! Generate a table of RFAL_ANALOG_CONFIG_LUT_SIZE IDs mixing modes, technologies, bit rates and directions */
+static uint16_t testGenTable(uint8_t *tbl)
+{
+  rfalAnalogConfigId id;
+  uint16_t           tech;
+  uint16_t           len = 0U;
+  uint16_t           k;
+
+  for (k = 0U; k < RFAL_ANALOG_CONFIG_LUT_SIZE; k++) {
+    /* Every 7th ID is shared by two technologies */
+    tech = (uint16_t)(RFAL_ANALOG_CONFIG_TECH_NFCA << ((k >> 1U) % 5U));
+    if ((k % 7U) == 6U) {
+      tech |= RFAL_ANALOG_CONFIG_TECH_NFCV;
+    }
+    id = (rfalAnalogConfigId)(((k >= 80U) ? RFAL_ANALOG_CONFIG_LISTEN : RFAL_ANALOG_CONFIG_POLL) | tech
+                              | ((((k / 10U) % 8U) << RFAL_ANALOG_CONFIG_BITRATE_SHIFT) & RFAL_ANALOG_CONFIG_BITRATE_MASK)
+                              | (((k & 0x01U) != 0U) ? RFAL_ANALOG_CONFIG_RX : RFAL_ANALOG_CONFIG_TX));
+
+    tbl[len++] = (uint8_t)(id >> 8U);
+    tbl[len++] = (uint8_t)(id & 0xFFU);
+    tbl[len++] = 1U;
+    tbl[len++] = 0x00U;
+    tbl[len++] = (uint8_t)k;
+    tbl[len++] = 0xFFU;
+    tbl[len++] = (uint8_t)k;
+  }
+  return len;
+}
+
+/*! Check both searches return the same Configuration Sets for every ID of \a ids */
+static void testCompare(IndexRfal &rf, const rfalAnalogConfigId *ids, uint16_t n)
+{
+  uint16_t linear[TEST_MAX_MATCHES];
+  uint16_t indexed[TEST_MAX_MATCHES];
+  uint16_t cntLinear;
+  uint16_t cntIndexed;
+  uint16_t q;
+  uint16_t m;
+
+  for (q = 0U; q < n; q++) {
+    cntLinear  = rf.searchAll(ids[q], false, linear);
+    cntIndexed = rf.searchAll(ids[q], true, indexed);
+
+    CHECK(cntLinear == cntIndexed);
+    for (m = 0U; (m < cntLinear) && (m < TEST_MAX_MATCHES); m++) {
+      CHECK(linear[m] == indexed[m]);
+    }
+  }
+}
+
+/*! Return the mean time of a complete search of one of \a ids, in ns */
+static double testBench(IndexRfal &rf, const rfalAnalogConfigId *ids, uint16_t n, bool indexed)
+{
+  uint16_t          offsets[TEST_MAX_MATCHES];
+  volatile uint32_t sink = 0U;
+  uint32_t          r;
+  uint16_t          q;
+
+  auto t0 = std::chrono::steady_clock::now();
+  for (r = 0U; r < TEST_BENCH_ROUNDS; r++) {
+    for (q = 0U; q < n; q++) {
+      sink = sink + rf.searchAll(ids[q], indexed, offsets);
+    }
+  }
+  auto t1 = std::chrono::steady_clock::now();
+
+  return ((double)std::chrono::duration_cast<std::chrono::nanoseconds>(t1 - t0).count() / ((double)TEST_BENCH_ROUNDS * n));
+}
+
+int main(void)
+{
+  static const uint16_t sizes[] = { 8U, 16U, 32U, 64U, 0U };
+  static uint8_t        genTbl[RFAL_ANALOG_CONFIG_LUT_SIZE * TEST_ENTRY_LEN];
+
+  SimChip            chip(TEST_INT_PIN);
+  IndexRfal          rf(&chip);
+  rfalAnalogConfigId ids[TEST_MAX_QUERIES];
+  uint16_t           n;
+  uint16_t           entries;
+  uint8_t            s;
+
+  rf.timerSetTimeSource(SimChip::time);
+
+  CHECK(rf.rfalInitialize() == ERR_NONE);
+  CHECK(rf.indexValid());
+
+  /* Default table: every ID gets the same Configuration Sets from both searches */
+  n = rf.queries(ids, 0U);
+  CHECK(n > 0U);
+  testCompare(rf, ids, n);
+
+  /* Generated table, cut to growing sizes, searched for its IDs and the default ones */
+  rf.load(genTbl, testGenTable(genTbl));
+  n = rf.queries(ids, n);
+
+  printf("Analog Configuration lookup, ns per searched ID (%u IDs searched):\n", (unsigned)n);
+  printf("%9s %10s %10s\n", "table IDs", "linear", "indexed");
+
+  for (s = 0U; s < SIZEOF_ARRAY(sizes); s++) {
+    entries = rf.truncate(sizes[s]);
+    CHECK(rf.indexValid());
+    testCompare(rf, ids, n);
+
+    printf("%9u %10.1f %10.1f\n", (unsigned)entries, testBench(rf, ids, n, false), testBench(rf, ids, n, true));
+  }
+
+  return TEST_RESULT();
+}
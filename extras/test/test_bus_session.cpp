@@ -0,0 +1,157 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Bus acquisitions with and without bus sessions
+ *
+ */
+
+#include "sim_chip.h"
+#include "test_common.h"
+
+#define TEST_INT_PIN                   6
+#define TEST_FWT_US                    5000U                          /*!< FWT of the transceives                  */
+#define TEST_LATENCY_US                300U                           /*!< Response time of the tag                */
+#define TEST_WORKER_STEP_US            5U                             /*!< Time elapsing between worker runs       */
+#define TEST_BUS_CONFIG_US             2U                             /*!< Cost of locking and configuring the bus */
+#define TEST_ROUNDS                    100U                           /*!< Rounds of each benchmarked operation    */
+
+
+/*! Simulated chip locking the bus around each transaction, as the SPI backend does */
+class LockChip : public SimChip {
+  public:
+    explicit LockChip(int pin) : SimChip(pin), depth(0U), acquisitions(0U) {}
+
+    void lock(void)
+    {
+      /* Only the outermost lock configures the bus */
+      if (depth == 0U) {
+        acquisitions++;
+        SimChip::run(TEST_BUS_CONFIG_US);
+      }
+      depth++;
+    }
+
+    void unlock(void)
+    {
+      depth--;
+    }
+
+    uint8_t  depth;
+    uint32_t acquisitions;
+
+  protected:
+    ReturnCode xfer(const uint8_t *hdr, uint8_t hdrLen, const uint8_t *txData, uint8_t *rxData, uint16_t length)
+    {
+      ReturnCode ret;
+
+      lock();
+      ret = SimChip::xfer(hdr, hdrLen, txData, rxData, length);
+      unlock();
+
+      return ret;
+    }
+};
+
+static const uint8_t testReq[]  = { 0x30U, 0x00U };
+static const uint8_t testResp[] = { 0x04U, 0x00U };
+
+/*! Run a transceive to completion */
+static ReturnCode testTransceive(RfalRfST25R200Class &rf)
+{
+  rfalTransceiveContext ctx;
+  uint8_t               rx[8];
+  uint16_t              rcvdLen;
+  uint32_t              loops;
+  ReturnCode            ret;
+
+  rfalCreateByteFlagsTxRxContext(ctx, testReq, sizeof(testReq), rx, sizeof(rx), &rcvdLen, RFAL_TXRX_FLAGS_DEFAULT, rfalConvUsTo1fc(TEST_FWT_US));
+
+  ret = rf.rfalStartTransceive(&ctx);
+  for (loops = 0; (ret == ERR_NONE) && (loops < 100000U); loops++) {
+    SimChip::run(TEST_WORKER_STEP_US);
+    rf.rfalWorker();
+    ret = rf.rfalGetTransceiveStatus();
+    if (ret != ERR_BUSY) {
+      break;
+    }
+    ret = ERR_NONE;
+  }
+
+  return ret;
+}
+
+/*! Report the transactions and bus acquisitions of \a rounds operations, check them against the session setting */
+static void testReport(const char *name, LockChip &chip)
+{
+  st25r200TransportStats st;
+
+  chip.getStats(&st);
+
+  printf("%-20s %6u transactions %6u bus acquisitions %7uus bus configuration\n", name, (unsigned)(st.transactions / TEST_ROUNDS),
+         (unsigned)(chip.acquisitions / TEST_ROUNDS), (unsigned)((chip.acquisitions * TEST_BUS_CONFIG_US) / TEST_ROUNDS));
+
+#if ST25R200_FEATURE_BUS_SESSION
+  CHECK(chip.acquisitions < st.transactions);
+#else
+  CHECK(chip.acquisitions <= st.transactions);
+#endif /* ST25R200_FEATURE_BUS_SESSION */
+  CHECK(chip.depth == 0U);
+
+  chip.resetStats();
+  chip.acquisitions = 0U;
+}
+
+int main(void)
+{
+  LockChip            chip(TEST_INT_PIN);
+  RfalRfST25R200Class rf(&chip, TEST_INT_PIN);
+  uint32_t            i;
+
+  rf.timerSetTimeSource(SimChip::time);
+
+  CHECK(rf.rfalInitialize() == ERR_NONE);
+  CHECK(rf.rfalFieldOnAndStartGT() == ERR_NONE);
+  chip.setTag(true, TEST_LATENCY_US, testResp, sizeof(testResp));
+
+  printf("bus sessions %s, per operation:\n", (ST25R200_FEATURE_BUS_SESSION ? "enabled" : "disabled"));
+
+  /* Alternate the modes so that every round configures the chip */
+  chip.resetStats();
+  chip.acquisitions = 0U;
+  for (i = 0; i < TEST_ROUNDS; i++) {
+    CHECK(rf.rfalSetMode((((i % 2U) == 0U) ? RFAL_MODE_POLL_NFCA : RFAL_MODE_POLL_NFCV), RFAL_BR_106, RFAL_BR_106) == ERR_NONE);
+  }
+  testReport("rfalSetMode", chip);
+
+  CHECK(rf.rfalSetMode(RFAL_MODE_POLL_NFCA, RFAL_BR_106, RFAL_BR_106) == ERR_NONE);
+  chip.resetStats();
+  chip.acquisitions = 0U;
+  for (i = 0; i < TEST_ROUNDS; i++) {
+    CHECK(testTransceive(rf) == ERR_NONE);
+  }
+  testReport("transceive", chip);
+
+  return TEST_RESULT();
+}
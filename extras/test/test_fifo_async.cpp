@@ -0,0 +1,223 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Asynchronous FIFO transfers: overlap, throughput and timeout
+ *
+ */
+
+#include "sim_chip.h"
+#include "test_common.h"
+
+#define TEST_INT_PIN                   4
+#define TEST_FWT_US                    5000U                          /*!< FWT of the transceives                */
+#define TEST_LATENCY_US                300U                           /*!< Response time of the tag              */
+#define TEST_TX_LEN                    200U                           /*!< Frame long enough for the hook        */
+#define TEST_RX_LEN                    64U                            /*!< FIFO read out through the hook        */
+#define TEST_SPI_BYTE_US               1U                             /*!< DMA time per byte, 8MHz SPI           */
+#define TEST_WORKER_STEP_US            5U                             /*!< Time elapsing between worker runs     */
+
+
+/*! Simulated chip whose FIFO data phase is moved by a simulated DMA */
+class DmaChip : public SimChip {
+  public:
+    explicit DmaChip(int pin) : SimChip(pin), rf(NULL), stalled(false), pending(false), dueUs(0U), dmaTx(NULL), dmaRx(NULL), dmaLen(0U), hdr(0U), ends(0U), bytes(0U) {}
+
+    /*! Transfer hook: the data phase completes TEST_SPI_BYTE_US per byte later, or never once stalled */
+    static ReturnCode hook(void *ctx, const uint8_t *txData, uint8_t *rxData, uint16_t length)
+    {
+      DmaChip *chip = (DmaChip *)ctx;
+
+      chip->pending = true;
+      chip->dueUs   = (SimChip::time() + (length * TEST_SPI_BYTE_US));
+      chip->dmaTx   = txData;
+      chip->dmaRx   = rxData;
+      chip->dmaLen  = length;
+      return ERR_NONE;
+    }
+
+    /*! DMA completion interrupt */
+    void poll(void)
+    {
+      if (pending && !stalled && ((int32_t)(SimChip::time() - dueUs) >= 0)) {
+        pending = false;
+        bytes  += dmaLen;
+        SimChip::xfer(&hdr, 1U, dmaTx, dmaRx, dmaLen);
+        rf->st25r200FifoXferDone();
+      }
+    }
+
+    RfalRfST25R200Class *rf;
+    bool                 stalled;
+    bool                 pending;
+    uint32_t             dueUs;
+    const uint8_t       *dmaTx;
+    uint8_t             *dmaRx;
+    uint16_t             dmaLen;
+    uint8_t              hdr;
+    uint32_t             ends;
+    uint32_t             bytes;
+
+  protected:
+    bool xferStart(const uint8_t *h, uint8_t hLen)
+    {
+      hdr = h[0];
+      NO_WARNING(hLen);
+      return true;
+    }
+
+    ReturnCode xferData(const uint8_t *txData, uint8_t *rxData, uint16_t length)
+    {
+      return SimChip::xfer(&hdr, 1U, txData, rxData, length);
+    }
+
+    void xferEnd(void)
+    {
+      pending = false;
+      ends++;
+    }
+};
+
+static uint8_t       testReq[TEST_TX_LEN];
+static const uint8_t testResp[] = { 0x00U, 0x01U, 0x02U, 0x03U, 0x04U, 0x05U, 0x06U, 0x07U, 0x08U, 0x09U, 0x0AU, 0x0BU, 0x0CU, 0x0DU, 0x0EU, 0x0FU };
+
+/*! Run a transceive to completion, counting the worker runs that found a DMA transfer ongoing */
+static ReturnCode testTransceive(RfalRfST25R200Class &rf, DmaChip &chip, uint32_t *overlapRuns)
+{
+  rfalTransceiveContext ctx;
+  uint8_t               rx[sizeof(testResp) + 4U];
+  uint16_t              rcvdLen;
+  uint32_t              loops;
+  ReturnCode            ret;
+
+  *overlapRuns = 0U;
+
+  rfalCreateByteFlagsTxRxContext(ctx, testReq, sizeof(testReq), rx, sizeof(rx), &rcvdLen, RFAL_TXRX_FLAGS_DEFAULT, rfalConvUsTo1fc(TEST_FWT_US));
+
+  ret = rf.rfalStartTransceive(&ctx);
+  if (ret != ERR_NONE) {
+    return ret;
+  }
+
+  for (loops = 0; loops < 100000U; loops++) {
+    SimChip::run(TEST_WORKER_STEP_US);
+    chip.poll();
+    rf.rfalWorker();
+    ret = rf.rfalGetTransceiveStatus();
+    if (ret != ERR_BUSY) {
+      break;
+    }
+
+    /* The worker returned with the bus owned by the DMA: the application runs meanwhile */
+    if (chip.pending) {
+      (*overlapRuns)++;
+    }
+  }
+
+  if ((ret == ERR_NONE) && ((rcvdLen != rfalConvBytesToBits(sizeof(testResp))) || (memcmp(rx, testResp, sizeof(testResp)) != 0))) {
+    return ERR_IO;
+  }
+  return ret;
+}
+
+int main(void)
+{
+  DmaChip                chip(TEST_INT_PIN);
+  RfalRfST25R200Class    rf(&chip, TEST_INT_PIN);
+  st25r200TransportStats st;
+  uint32_t               overlap;
+  uint32_t               frames;
+  uint32_t               ends;
+  uint32_t               start;
+  uint16_t               i;
+  uint8_t                val;
+  uint8_t                rx[TEST_RX_LEN];
+
+  for (i = 0; i < sizeof(testReq); i++) {
+    testReq[i] = (uint8_t)i;
+  }
+
+  chip.rf = &rf;
+  rf.timerSetTimeSource(SimChip::time);
+
+  CHECK(rf.rfalInitialize() == ERR_NONE);
+  CHECK(rf.rfalSetMode(RFAL_MODE_POLL_NFCA, RFAL_BR_106, RFAL_BR_106) == ERR_NONE);
+  CHECK(rf.rfalFieldOnAndStartGT() == ERR_NONE);
+  chip.setTag(true, TEST_LATENCY_US, testResp, sizeof(testResp));
+
+  /* Blocking reference: no worker run finds the bus busy */
+  CHECK(testTransceive(rf, chip, &overlap) == ERR_NONE);
+  CHECK(overlap == 0U);
+  CHECK(chip.getFrameLen() == TEST_TX_LEN);
+
+  /* With the hook, the frame load and the response read out overlap the worker */
+  CHECK(rf.st25r200SetFifoXferHook(DmaChip::hook, &chip) == ERR_NONE);
+  chip.getStats(&st);
+  chip.resetStats();
+  CHECK(testTransceive(rf, chip, &overlap) == ERR_NONE);
+  CHECK(overlap >= ((TEST_TX_LEN * TEST_SPI_BYTE_US) / TEST_WORKER_STEP_US) / 2U);
+  CHECK(chip.getFrameLen() == TEST_TX_LEN);
+  CHECK(chip.bytes == TEST_TX_LEN);
+  chip.getStats(&st);
+  CHECK(st.bytesTx >= TEST_TX_LEN);
+  CHECK(st.bytesRx >= (sizeof(testResp) + RFAL_CRC_LEN));
+
+  printf("%u byte frame: %u worker runs overlapping the DMA, %u transactions, %u bytes sent, %u received\n",
+         TEST_TX_LEN, (unsigned)overlap, (unsigned)st.transactions, (unsigned)st.bytesTx, (unsigned)st.bytesRx);
+
+  /* A FIFO read out started returns at once, the data is there once the bus is released */
+  CHECK(chip.fifoLoad(testReq, TEST_RX_LEN) == TEST_RX_LEN);
+  ST_MEMSET(rx, 0x00, sizeof(rx));
+  CHECK(rf.st25r200ReadFifoStart(rx, TEST_RX_LEN) == ERR_NONE);
+  for (overlap = 0; rf.st25r200FifoXferIsBusy(); overlap++) {
+    chip.poll();
+  }
+  CHECK(overlap > 0U);
+  CHECK(memcmp(rx, testReq, TEST_RX_LEN) == 0);
+
+  /* A DMA never completing is aborted: the bus is released and the transceive fails without a frame sent */
+  chip.stalled = true;
+  frames = chip.getFrames();
+  ends   = chip.ends;
+  start  = SimChip::time();
+  CHECK(testTransceive(rf, chip, &overlap) == ERR_IO);
+  CHECK((SimChip::time() - start) >= ST25R200_FIFO_XFER_TOUT_US);
+  CHECK(chip.getFrames() == frames);
+  CHECK(chip.ends == (ends + 1U));
+
+  /* The next transceive is not affected */
+  chip.stalled = false;
+  CHECK(testTransceive(rf, chip, &overlap) == ERR_NONE);
+
+  /* Outside a transceive the next access reports the aborted transfer, once */
+  chip.stalled = true;
+  CHECK(rf.st25r200WriteFifoStart(testReq, sizeof(testReq)) == ERR_NONE);
+  CHECK(rf.st25r200FifoXferIsBusy());
+  SimChip::run(ST25R200_FIFO_XFER_TOUT_US);
+  CHECK(rf.st25r200ReadRegister(ST25R200_REG_OPERATION, &val) == ERR_TIMEOUT);
+  CHECK(rf.st25r200ReadRegister(ST25R200_REG_OPERATION, &val) == ERR_NONE);
+  chip.stalled = false;
+
+  return TEST_RESULT();
+}
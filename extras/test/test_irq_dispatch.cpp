@@ -0,0 +1,126 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Per-instance interrupt dispatch: N readers on simulated chips
+ *
+ */
+
+#include "sim_chip.h"
+#include "host_arduino.h"
+#include "test_common.h"
+
+#define TEST_READERS                   ST25R200_IRQ_DISPATCH_SLOTS
+#define TEST_PIN_BASE                  10
+
+static SimChip             *chip[TEST_READERS];
+static RfalRfST25R200Class *rf[TEST_READERS];
+
+/*! Interrupt raised on reader \a n, distinct per reader */
+static uint32_t testIrq(uint8_t n)
+{
+  return ((uint32_t)1U << n) | ((uint32_t)1U << (n + 8U));
+}
+
+/*! Check that every reader sees exactly the interrupts raised on its own chip */
+static void testNoCross(const uint32_t *expected)
+{
+  uint8_t n;
+
+  for (n = 0; n < TEST_READERS; n++) {
+    CHECK(rf[n]->st25r200GetInterrupt(ST25R200_IRQ_MASK_ALL) == expected[n]);
+  }
+}
+
+int main(void)
+{
+  uint32_t expected[TEST_READERS];
+  uint8_t  n;
+  uint8_t  k;
+
+  for (n = 0; n < TEST_READERS; n++) {
+    chip[n] = new SimChip(TEST_PIN_BASE + n);
+    rf[n]   = new RfalRfST25R200Class(chip[n], (TEST_PIN_BASE + n));
+    rf[n]->timerSetTimeSource(SimChip::time);
+    CHECK(rf[n]->rfalInitialize() == ERR_NONE);
+    rf[n]->st25r200GetInterrupt(ST25R200_IRQ_MASK_ALL);
+  }
+
+  /* Every reader has its own entry point */
+  for (n = 0; n < TEST_READERS; n++) {
+    CHECK(hostGetIrqHandler(TEST_PIN_BASE + n) != NULL);
+    for (k = 0; k < n; k++) {
+      CHECK(hostGetIrqHandler(TEST_PIN_BASE + n) != hostGetIrqHandler(TEST_PIN_BASE + k));
+    }
+  }
+
+  /* One reader interrupted at a time */
+  for (k = 0; k < TEST_READERS; k++) {
+    for (n = 0; n < TEST_READERS; n++) {
+      expected[n] = ((n == k) ? testIrq(k) : ST25R200_IRQ_MASK_NONE);
+    }
+    chip[k]->raise(testIrq(k));
+    testNoCross(expected);
+  }
+
+  /* All readers interrupted before any of them is served by the application */
+  for (n = TEST_READERS; n > 0U; n--) {
+    chip[n - 1U]->raise(testIrq(n - 1U));
+    expected[n - 1U] = testIrq(n - 1U);
+  }
+  testNoCross(expected);
+
+  /* No slot left for one more reader */
+  {
+    SimChip             extraChip(TEST_PIN_BASE + TEST_READERS);
+    RfalRfST25R200Class extra(&extraChip, (TEST_PIN_BASE + TEST_READERS));
+
+    extra.timerSetTimeSource(SimChip::time);
+    CHECK(extra.rfalInitialize() == ERR_NOMEM);
+    CHECK(hostGetIrqHandler(TEST_PIN_BASE + TEST_READERS) == NULL);
+  }
+
+  /* A released slot is reused, the other readers keep theirs */
+  delete rf[1];
+  CHECK(hostGetIrqHandler(TEST_PIN_BASE + 1) == NULL);
+  rf[1] = new RfalRfST25R200Class(chip[1], (TEST_PIN_BASE + 1));
+  rf[1]->timerSetTimeSource(SimChip::time);
+  CHECK(rf[1]->rfalInitialize() == ERR_NONE);
+  rf[1]->st25r200GetInterrupt(ST25R200_IRQ_MASK_ALL);
+
+  for (k = 0; k < TEST_READERS; k++) {
+    for (n = 0; n < TEST_READERS; n++) {
+      expected[n] = ((n == k) ? testIrq(k) : ST25R200_IRQ_MASK_NONE);
+    }
+    chip[k]->raise(testIrq(k));
+    testNoCross(expected);
+  }
+
+  for (n = 0; n < TEST_READERS; n++) {
+    delete rf[n];
+    delete chip[n];
+  }
+
+  return TEST_RESULT();
+}
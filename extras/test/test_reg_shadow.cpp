@@ -0,0 +1,95 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Register bits skipped or rewritten according to the register shadow
+ *
+ */
+
+#include "sim_chip.h"
+#include "test_common.h"
+
+#define TEST_INT_PIN                   5
+#define TEST_NRT_64FC                  1000U                          /*!< No-response time programmed         */
+#define TEST_CONFIG_ID                 (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_106 | RFAL_ANALOG_CONFIG_RX)
+#define TEST_CONFIG_MASK               (ST25R200_REG_RX_DIG_lpf_coef_mask | ST25R200_REG_RX_DIG_hpf_coef_mask) /*!< RX_DIG bits set by TEST_CONFIG_ID */
+
+/*! Bus transactions performed by the last call */
+static uint32_t testTransactions(SimChip &chip)
+{
+  st25r200TransportStats st;
+
+  chip.getStats(&st);
+  chip.resetStats();
+  return st.transactions;
+}
+
+int main(void)
+{
+  SimChip             chip(TEST_INT_PIN);
+  RfalRfST25R200Class rf(&chip, TEST_INT_PIN);
+  uint8_t             cfg;
+
+  rf.timerSetTimeSource(SimChip::time);
+
+  CHECK(rf.rfalInitialize() == ERR_NONE);
+
+  /* A configuration already in place needs no bus access */
+  CHECK(rf.rfalSetAnalogConfig(TEST_CONFIG_ID) == ERR_NONE);
+  cfg = (uint8_t)(chip.getRegister(ST25R200_REG_RX_DIG) & TEST_CONFIG_MASK);
+  testTransactions(chip);
+  CHECK(rf.rfalSetAnalogConfig(TEST_CONFIG_ID) == ERR_NONE);
+  CHECK(testTransactions(chip) == 0U);
+
+  /* A write by anyone else is seen, the configuration is written again */
+  CHECK(rf.st25r200WriteRegister(ST25R200_REG_RX_DIG, (uint8_t)~cfg) == ERR_NONE);
+  CHECK(rf.rfalSetAnalogConfig(TEST_CONFIG_ID) == ERR_NONE);
+  CHECK((chip.getRegister(ST25R200_REG_RX_DIG) & TEST_CONFIG_MASK) == cfg);
+
+  /* So is a change still queued in a batch */
+  rf.st25r200BatchBegin();
+  CHECK(rf.st25r200ChangeRegisterBits(ST25R200_REG_RX_DIG, TEST_CONFIG_MASK, (uint8_t)~cfg) == ERR_NONE);
+  CHECK(rf.rfalSetAnalogConfig(TEST_CONFIG_ID) == ERR_NONE);
+  CHECK(rf.st25r200BatchCommit() == ERR_NONE);
+  CHECK((chip.getRegister(ST25R200_REG_RX_DIG) & TEST_CONFIG_MASK) == cfg);
+
+  /* A change behind the driver is only seen once the shadow is invalidated */
+  chip.setRegister(ST25R200_REG_RX_DIG, (uint8_t)~cfg);
+  rf.st25r200ShadowInvalidate();
+  CHECK(rf.rfalSetAnalogConfig(TEST_CONFIG_ID) == ERR_NONE);
+  CHECK((chip.getRegister(ST25R200_REG_RX_DIG) & TEST_CONFIG_MASK) == cfg);
+
+  /* Identical timings across frames need no bus access */
+  CHECK(rf.st25r200SetNoResponseTime(TEST_NRT_64FC) == ERR_NONE);
+  testTransactions(chip);
+  CHECK(rf.st25r200SetNoResponseTime(TEST_NRT_64FC) == ERR_NONE);
+  CHECK(testTransactions(chip) == 0U);
+
+  /* Set Default restores the reset values, the timings are programmed again */
+  CHECK(rf.st25r200ExecuteCommand(ST25R200_CMD_SET_DEFAULT) == ERR_NONE);
+  CHECK(rf.st25r200SetNoResponseTime(TEST_NRT_64FC) == ERR_NONE);
+  CHECK((((uint16_t)chip.getRegister(ST25R200_REG_NRT1) << 8U) | chip.getRegister(ST25R200_REG_NRT2)) == TEST_NRT_64FC);
+
+  return TEST_RESULT();
+}
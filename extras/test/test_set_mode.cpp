@@ -0,0 +1,107 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Bus transactions per rfalSetMode()
+ *
+ */
+
+#include "sim_chip.h"
+#include "test_common.h"
+
+#define TEST_INT_PIN                   7
+
+/*! Poll modes and their bit rate */
+typedef struct {
+  rfalMode    mode;
+  rfalBitRate br;
+  const char *name;
+} testMode;
+
+static const testMode testModes[] = {
+  { RFAL_MODE_POLL_NFCA,     RFAL_BR_106,   "NFC-A"    },
+  { RFAL_MODE_POLL_NFCA_T1T, RFAL_BR_106,   "NFC-A T1T" },
+  { RFAL_MODE_POLL_NFCB,     RFAL_BR_106,   "NFC-B"    },
+  { RFAL_MODE_POLL_B_PRIME,  RFAL_BR_106,   "B'"       },
+  { RFAL_MODE_POLL_B_CTS,    RFAL_BR_106,   "B CTS"    },
+  { RFAL_MODE_POLL_NFCV,     RFAL_BR_26p48, "NFC-V"    },
+  { RFAL_MODE_POLL_PICOPASS, RFAL_BR_26p48, "PicoPass" },
+};
+
+/*! Set \a m and return the bus transactions it took */
+static uint32_t testSetMode(RfalRfST25R200Class &rf, SimChip &chip, const testMode *m, uint32_t *bytes)
+{
+  st25r200TransportStats st;
+
+  chip.resetStats();
+  CHECK(rf.rfalSetMode(m->mode, m->br, m->br) == ERR_NONE);
+  CHECK(rf.rfalGetMode() == m->mode);
+  chip.getStats(&st);
+
+  *bytes = (st.bytesTx + st.bytesRx);
+  return st.transactions;
+}
+
+int main(void)
+{
+  SimChip             chip(TEST_INT_PIN);
+  RfalRfST25R200Class rf(&chip, TEST_INT_PIN);
+  const testMode      *prev;
+  uint32_t            change;
+  uint32_t            changeBytes;
+  uint32_t            same;
+  uint32_t            sameBytes;
+  uint8_t             regs[ST25R200_REG_IC_ID + 1U];
+  uint8_t             reg;
+  uint8_t             i;
+
+  rf.timerSetTimeSource(SimChip::time);
+
+  CHECK(rf.rfalInitialize() == ERR_NONE);
+
+  printf("register batch %s, transactions (bytes) per rfalSetMode:\n", (ST25R200_FEATURE_REG_BATCH ? "enabled" : "disabled"));
+  printf("%-10s %16s %16s\n", "mode", "mode change", "same mode");
+
+  for (i = 0; i < SIZEOF_ARRAY(testModes); i++) {
+    /* From a mode of another technology, then again once set */
+    prev = &testModes[(testModes[i].mode == RFAL_MODE_POLL_NFCV) ? 0U : 5U];
+    testSetMode(rf, chip, prev, &changeBytes);
+
+    change = testSetMode(rf, chip, &testModes[i], &changeBytes);
+    for (reg = 0; reg <= ST25R200_REG_IC_ID; reg++) {
+      regs[reg] = chip.getRegister(reg);
+    }
+    same   = testSetMode(rf, chip, &testModes[i], &sameBytes);
+
+    printf("%-10s %8u (%4u) %8u (%4u)\n", testModes[i].name, (unsigned)change, (unsigned)changeBytes, (unsigned)same, (unsigned)sameBytes);
+
+    /* Setting the mode in place again changes no register */
+    CHECK(same <= change);
+    for (reg = 0; reg <= ST25R200_REG_IC_ID; reg++) {
+      CHECK(chip.getRegister(reg) == regs[reg]);
+    }
+  }
+
+  return TEST_RESULT();
+}
@@ -0,0 +1,108 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Communication layer on the mock transport: data and byte counters
+ *
+ */
+
+#include "rfal_rfst25r200.h"
+#include "test_common.h"
+
+#define TEST_INT_PIN                   2
+
+int main(void)
+{
+  ST25R200MockTransport  mock;
+  RfalRfST25R200Class    rf(&mock, TEST_INT_PIN);
+  st25r200TransportStats st;
+  uint8_t                buf[16];
+  uint8_t                val;
+  uint8_t                i;
+
+  CHECK(rf.st25r200GetTransport() == &mock);
+
+  /* Register write: header plus one data byte */
+  mock.resetStats();
+  CHECK(rf.st25r200WriteRegister(ST25R200_REG_TX_DRIVER, 0xA5U) == ERR_NONE);
+  mock.getStats(&st);
+  CHECK(mock.getRegister(ST25R200_REG_TX_DRIVER) == 0xA5U);
+  CHECK((st.transactions == 1U) && (st.bytesTx == 2U) && (st.bytesRx == 0U));
+  CHECK((st.lastTx == 2U) && (st.lastRx == 0U));
+
+  /* Burst read with auto-increment: one header, one transaction */
+  mock.setRegister(ST25R200_REG_CORR1, 0x11U);
+  mock.setRegister(ST25R200_REG_CORR2, 0x22U);
+  mock.setRegister(ST25R200_REG_CORR3, 0x33U);
+  mock.resetStats();
+  CHECK(rf.st25r200ReadMultipleRegisters(ST25R200_REG_CORR1, buf, 3U) == ERR_NONE);
+  mock.getStats(&st);
+  CHECK((buf[0] == 0x11U) && (buf[1] == 0x22U) && (buf[2] == 0x33U));
+  CHECK((st.transactions == 1U) && (st.bytesTx == 1U) && (st.bytesRx == 3U));
+  CHECK((st.lastTx == 1U) && (st.lastRx == 3U));
+
+  /* FIFO write and read */
+  for (i = 0; i < sizeof(buf); i++) {
+    buf[i] = i;
+  }
+  mock.resetStats();
+  CHECK(rf.st25r200WriteFifo(buf, sizeof(buf)) == ERR_NONE);
+  mock.getStats(&st);
+  CHECK((st.transactions == 1U) && (st.bytesTx == (1U + sizeof(buf))));
+  CHECK(mock.getRegister(ST25R200_REG_FIFO_STATUS1) == sizeof(buf));
+
+  ST_MEMSET(buf, 0x00, sizeof(buf));
+  mock.resetStats();
+  CHECK(rf.st25r200ReadFifo(buf, 10U) == ERR_NONE);
+  mock.getStats(&st);
+  CHECK((buf[0] == 0U) && (buf[9] == 9U));
+  CHECK((st.transactions == 1U) && (st.bytesTx == 1U) && (st.bytesRx == 10U));
+  CHECK(mock.getRegister(ST25R200_REG_FIFO_STATUS1) == (sizeof(buf) - 10U));
+
+  /* Direct command: header only */
+  mock.resetStats();
+  CHECK(rf.st25r200ExecuteCommand(ST25R200_CMD_CLEAR_FIFO) == ERR_NONE);
+  mock.getStats(&st);
+  CHECK(mock.getLastCommand() == ST25R200_CMD_CLEAR_FIFO);
+  CHECK(mock.getRegister(ST25R200_REG_FIFO_STATUS1) == 0U);
+  CHECK((st.transactions == 1U) && (st.bytesTx == 1U) && (st.bytesRx == 0U));
+
+  /* Test register access: two header bytes */
+  mock.resetStats();
+  CHECK(rf.st25r200WriteTestRegister(0x04U, 0x5AU) == ERR_NONE);
+  CHECK(rf.st25r200ReadTestRegister(0x04U, &val) == ERR_NONE);
+  mock.getStats(&st);
+  CHECK((val == 0x5AU) && (mock.getTestRegister(0x04U) == 0x5AU));
+  CHECK((st.transactions == 2U) && (st.bytesTx == 5U) && (st.bytesRx == 1U));
+
+  /* Read-modify-write of a register bit field */
+  mock.setRegister(ST25R200_REG_TX_DRIVER, 0xF0U);
+  mock.resetStats();
+  CHECK(rf.st25r200ChangeRegisterBits(ST25R200_REG_TX_DRIVER, 0x0FU, 0x05U) == ERR_NONE);
+  mock.getStats(&st);
+  CHECK(mock.getRegister(ST25R200_REG_TX_DRIVER) == 0xF5U);
+  CHECK((st.transactions == 2U) && (st.bytesTx == 3U) && (st.bytesRx == 1U));
+
+  return TEST_RESULT();
+}
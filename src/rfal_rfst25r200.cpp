@@ -37,17 +37,98 @@
 
 #include "rfal_rfst25r200.h"
 
+/*
+******************************************************************************
+* LOCAL DEFINES
+******************************************************************************
+*/
+
+#define RFAL_TXRX_FLAGS_TX1_MASK       (ST25R200_REG_PROTOCOL_TX1_tx_crc | ST25R200_REG_PROTOCOL_TX1_a_tx_par)  /*!< PROTOCOL_TX1 bits driven by the transceive flags */
+#define RFAL_TXRX_FLAGS_RX1_MASK       (ST25R200_REG_PROTOCOL_RX1_a_rx_par | ST25R200_REG_PROTOCOL_RX1_rx_crc)  /*!< PROTOCOL_RX1 bits driven by the transceive flags */
+
+#define RFAL_MODE_B_TX2_MASK           (ST25R200_REG_PROTOCOL_TX2_b_tx_sof_mask | ST25R200_REG_PROTOCOL_TX2_b_tx_eof)                                                   /*!< NFC-B Tx SOF and EOF bits */
+#define RFAL_MODE_B_TX2_VAL            (ST25R200_REG_PROTOCOL_TX2_b_tx_sof_0_10etu | ST25R200_REG_PROTOCOL_TX2_b_tx_sof_1_2etu | ST25R200_REG_PROTOCOL_TX2_b_tx_eof_10etu) /*!< NFC-B Tx SOF and EOF      */
+#define RFAL_MODE_B_RX1_MASK           (ST25R200_REG_PROTOCOL_RX1_b_rx_sof | ST25R200_REG_PROTOCOL_RX1_b_rx_eof)                                                        /*!< NFC-B Rx SOF and EOF bits */
+
+/*
+******************************************************************************
+* LOCAL VARIABLES
+******************************************************************************
+*/
+
+/*! Mode descriptors, indexed by mode starting from RFAL_MODE_POLL_NFCA */
+static const rfalModeDesc rfalModeDescTbl[] = {
+  /* mode                         supported  protocol                            tx2Mask               tx2Val               rx1Mask               rx1Val                                                                 rx2Mask                                      rx2Val       analogTech                                                      fdtListenAdj                  fwtAdj                */
+  { RFAL_MODE_POLL_NFCA,          true,      ST25R200_REG_PROTOCOL_om_iso14443a, 0x00U,                0x00U,               0x00U,                0x00U,                                                                 0x00U,                                       0x00U,       (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA),       RFAL_FDT_LISTEN_A_ADJUSTMENT, RFAL_FWT_A_ADJUSTMENT },
+  { RFAL_MODE_POLL_NFCA_T1T,      true,      ST25R200_REG_PROTOCOL_om_topaz,     0x00U,                0x00U,               0x00U,                0x00U,                                                                 0x00U,                                       0x00U,       (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA),       RFAL_FDT_LISTEN_A_ADJUSTMENT, RFAL_FWT_A_ADJUSTMENT },
+  { RFAL_MODE_POLL_NFCB,          true,      ST25R200_REG_PROTOCOL_om_iso14443b, RFAL_MODE_B_TX2_MASK, RFAL_MODE_B_TX2_VAL, RFAL_MODE_B_RX1_MASK, (ST25R200_REG_PROTOCOL_RX1_b_rx_sof | ST25R200_REG_PROTOCOL_RX1_b_rx_eof), ST25R200_REG_PROTOCOL_RX2_tr1_min_len_mask, RFAL_TR1MIN, (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB),       RFAL_FDT_LISTEN_B_ADJUSTMENT, RFAL_FWT_B_ADJUSTMENT },
+  { RFAL_MODE_POLL_B_PRIME,       true,      ST25R200_REG_PROTOCOL_om_iso14443b, RFAL_MODE_B_TX2_MASK, RFAL_MODE_B_TX2_VAL, RFAL_MODE_B_RX1_MASK, ST25R200_REG_PROTOCOL_RX1_b_rx_eof,                                    ST25R200_REG_PROTOCOL_RX2_tr1_min_len_mask, RFAL_TR1MIN, (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB),       0U,                           0U                    },
+  { RFAL_MODE_POLL_B_CTS,         true,      ST25R200_REG_PROTOCOL_om_iso14443b, RFAL_MODE_B_TX2_MASK, RFAL_MODE_B_TX2_VAL, RFAL_MODE_B_RX1_MASK, 0x00U,                                                                 ST25R200_REG_PROTOCOL_RX2_tr1_min_len_mask, RFAL_TR1MIN, (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB),       0U,                           0U                    },
+  { RFAL_MODE_POLL_NFCF,          false,     0x00U,                              0x00U,                0x00U,               0x00U,                0x00U,                                                                 0x00U,                                       0x00U,       0x0000U,                                                        0U,                           0U                    },
+  { RFAL_MODE_POLL_NFCV,          true,      ST25R200_REG_PROTOCOL_om_iso15693,  0x00U,                0x00U,               0x00U,                0x00U,                                                                 0x00U,                                       0x00U,       (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV),       RFAL_FDT_LISTEN_V_ADJUSTMENT, RFAL_FWT_V_ADJUSTMENT },
+  { RFAL_MODE_POLL_PICOPASS,      true,      ST25R200_REG_PROTOCOL_om_iso15693,  0x00U,                0x00U,               0x00U,                0x00U,                                                                 0x00U,                                       0x00U,       (RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV),       0U,                           0U                    },
+  { RFAL_MODE_POLL_ACTIVE_P2P,    false,     0x00U,                              0x00U,                0x00U,               0x00U,                0x00U,                                                                 0x00U,                                       0x00U,       0x0000U,                                                        0U,                           0U                    },
+  { RFAL_MODE_LISTEN_NFCA,        false,     0x00U,                              0x00U,                0x00U,               0x00U,                0x00U,                                                                 0x00U,                                       0x00U,       0x0000U,                                                        0U,                           0U                    },
+  { RFAL_MODE_LISTEN_NFCB,        false,     0x00U,                              0x00U,                0x00U,               0x00U,                0x00U,                                                                 0x00U,                                       0x00U,       0x0000U,                                                        0U,                           0U                    },
+  { RFAL_MODE_LISTEN_NFCF,        false,     0x00U,                              0x00U,                0x00U,               0x00U,                0x00U,                                                                 0x00U,                                       0x00U,       0x0000U,                                                        0U,                           0U                    },
+  { RFAL_MODE_LISTEN_ACTIVE_P2P,  false,     0x00U,                              0x00U,                0x00U,               0x00U,                0x00U,                                                                 0x00U,                                       0x00U,       0x0000U,                                                        0U,                           0U                    },
+};
+
+/*******************************************************************************/
+RfalRfST25R200Class::RfalRfST25R200Class(SPIClass *spi, int cs_pin, int int_pin, int reset_pin, uint32_t spi_speed) : spiTransport(spi, cs_pin, spi_speed), transport(&spiTransport), int_pin(int_pin), reset_pin(reset_pin)
+{
+  rfalInitInstance();
+}
+
+
 /*******************************************************************************/
-RfalRfST25R200Class::RfalRfST25R200Class(SPIClass *spi, int cs_pin, int int_pin, int reset_pin, uint32_t spi_speed) : dev_spi(spi), cs_pin(cs_pin), int_pin(int_pin), reset_pin(reset_pin), spi_speed(spi_speed)
+RfalRfST25R200Class::RfalRfST25R200Class(ST25R200Transport *transport, int int_pin, int reset_pin) : spiTransport(NULL, -1, 0), transport(transport), int_pin(int_pin), reset_pin(reset_pin)
+{
+  rfalInitInstance();
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalInitInstance(void)
 {
   memset(&gRFAL, 0, sizeof(rfal));
   memset(&gRfalAnalogConfigMgmt, 0, sizeof(rfalAnalogConfigMgmt));
   memset(&rfalIso15693PhyConfig, 0, sizeof(rfalIso15693PhyConfig_t));
   gST25R200NRT_64fcs = 0;
+  memset(&st25r200Shadow, 0, sizeof(st25r200ShadowRegs));
+#if ST25R200_FEATURE_REG_BATCH
+  memset(&st25r200Batch, 0, sizeof(st25r200RegBatch));
+#endif /* ST25R200_FEATURE_REG_BATCH */
+#if ST25R200_FEATURE_FIFO_ASYNC
+  memset(&st25r200Xfer, 0, sizeof(st25r200FifoXfer));
+#endif /* ST25R200_FEATURE_FIFO_ASYNC */
+#if ST25R200_FEATURE_BUS_SESSION
+  st25r200SessionDepth = 0U;
+  st25r200SessionLocked = false;
+#endif /* ST25R200_FEATURE_BUS_SESSION */
   memset((void *)&st25r200interrupt, 0, sizeof(st25r200Interrupt));
+#if ST25R200_FEATURE_DEFERRED_IRQ
+  memset((void *)&st25r200IrqEvts, 0, sizeof(st25r200IrqRing));
+#endif /* ST25R200_FEATURE_DEFERRED_IRQ */
+#if ST25R200_FEATURE_ADAPTIVE_FWT
+  memset((void *)&gRfalAfwt, 0, sizeof(rfalAdaptiveFwt));
+#endif /* ST25R200_FEATURE_ADAPTIVE_FWT */
   timerStopwatchTick = 0;
+  timerSource = NULL;
+#if ST25R200_FEATURE_PROFILER
+  rfalProfReset();
+#endif /* ST25R200_FEATURE_PROFILER */
   isr_pending = false;
   irq_handler = NULL;
+  irq_slot = ST25R200_IRQ_DISPATCH_SLOTS;
+}
+
+
+/*******************************************************************************/
+RfalRfST25R200Class::~RfalRfST25R200Class()
+{
+  /* Do not leave a dangling instance in the interrupt dispatch table */
+  st25r200IsrDetach();
 }
 
 
@@ -61,13 +142,10 @@ ReturnCode RfalRfST25R200Class::rfalInitialize(void)
     digitalWrite(reset_pin, LOW);
   }
 
-  pinMode(cs_pin, OUTPUT);
-  digitalWrite(cs_pin, HIGH);
+  transport->begin();
 
   pinMode(int_pin, INPUT);
-  Callback<void()>::func = std::bind(&RfalRfST25R200Class::st25r200Isr, this);
-  irq_handler = static_cast<ST25R200IrqHandler>(Callback<void()>::callback);
-  attachInterrupt(int_pin, irq_handler, RISING);
+  EXIT_ON_ERR(err, st25r200IsrAttach());
 
   rfalAnalogConfigInitialize();              /* Initialize RFAL's Analog Configs */
 
@@ -111,6 +189,18 @@ ReturnCode RfalRfST25R200Class::rfalInitialize(void)
   gRFAL.callbacks.postTxRx = NULL;
   gRFAL.callbacks.syncTxRx = NULL;
 
+  gRFAL.TxRx.doneCb        = NULL;
+  gRFAL.TxRx.doneCbCtx     = NULL;
+  gRFAL.TxRx.stream.cb     = NULL;
+  gRFAL.TxRx.txSeg         = NULL;
+  gRFAL.TxRx.txSegCnt      = 0;
+  gRFAL.TxRx.retry.maxAttempts = 0;
+  gRFAL.TxRx.attempt       = 0;
+
+  gRFAL.txrxFlagsRestore   = false;
+
+  ST_MEMSET(&gRfalTxRxQueue, 0x00, sizeof(rfalTxRxQueue));
+
 #if RFAL_FEATURE_WAKEUP_MODE
   /* Initialize Wake-Up Mode */
   gRFAL.wum.state = RFAL_WUM_STATE_NOT_INIT;
@@ -199,12 +289,17 @@ void RfalRfST25R200Class::rfalSetLmEonCallback(rfalLmEonCallback pFunc)
 /*******************************************************************************/
 ReturnCode RfalRfST25R200Class::rfalDeinitialize(void)
 {
+  /* Leave the transceive flags on their defaults */
+  rfalRestoreTransceiveFlags();
+
   /* Deinitialize chip */
   st25r200Deinitialize();
 
   /* Set Analog configurations for deinitialization */
   rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_DEINIT));
 
+  st25r200IsrDetach();
+
   gRFAL.state = RFAL_STATE_IDLE;
   return ERR_NONE;
 }
@@ -242,6 +337,9 @@ void RfalRfST25R200Class::rfalDisableObsvMode(void)
 /*******************************************************************************/
 ReturnCode RfalRfST25R200Class::rfalSetMode(rfalMode mode, rfalBitRate txBR, rfalBitRate rxBR)
 {
+  ReturnCode         ret;
+  ReturnCode         retCommit;
+  const rfalModeDesc *desc;
 
   /* Check if RFAL is not initialized */
   if (gRFAL.state == RFAL_STATE_IDLE) {
@@ -253,134 +351,57 @@ ReturnCode RfalRfST25R200Class::rfalSetMode(rfalMode mode, rfalBitRate txBR, rfa
     return ERR_PARAM;
   }
 
-  switch (mode) {
-    /*******************************************************************************/
-    case RFAL_MODE_POLL_NFCA:
-
-      /* Enable ISO14443A mode */
-      st25r200WriteRegister(ST25R200_REG_PROTOCOL, ST25R200_REG_PROTOCOL_om_iso14443a);
-
-      /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
-      break;
-
-    /*******************************************************************************/
-    case RFAL_MODE_POLL_NFCA_T1T:
-
-      /* Enable Topaz mode */
-      st25r200WriteRegister(ST25R200_REG_PROTOCOL, ST25R200_REG_PROTOCOL_om_topaz);
-
-      /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCA | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
-      break;
-
-    /*******************************************************************************/
-    case RFAL_MODE_POLL_NFCB:
-
-      /* Enable ISO14443B mode */
-      st25r200WriteRegister(ST25R200_REG_PROTOCOL, ST25R200_REG_PROTOCOL_om_iso14443b);
-
-      /* Set Tx SOF and EOF */
-      st25r200ChangeRegisterBits(ST25R200_REG_PROTOCOL_TX2,
-                                 (ST25R200_REG_PROTOCOL_TX2_b_tx_sof_mask | ST25R200_REG_PROTOCOL_TX2_b_tx_eof),
-                                 (ST25R200_REG_PROTOCOL_TX2_b_tx_sof_0_10etu | ST25R200_REG_PROTOCOL_TX2_b_tx_sof_1_2etu | ST25R200_REG_PROTOCOL_TX2_b_tx_eof_10etu));
-
-      /* Set Rx SOF and EOF */
-      st25r200ChangeRegisterBits(ST25R200_REG_PROTOCOL_RX1,
-                                 (ST25R200_REG_PROTOCOL_RX1_b_rx_sof | ST25R200_REG_PROTOCOL_RX1_b_rx_eof),
-                                 (ST25R200_REG_PROTOCOL_RX1_b_rx_sof | ST25R200_REG_PROTOCOL_RX1_b_rx_eof));
-
-      /* Set the minimum TR1 (excluding start_wait) */
-      st25r200ChangeRegisterBits(ST25R200_REG_PROTOCOL_RX2, ST25R200_REG_PROTOCOL_RX2_tr1_min_len_mask, RFAL_TR1MIN);
-
-      /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
-      break;
-
-    /*******************************************************************************/
-    case RFAL_MODE_POLL_B_PRIME:
-
-      /* Enable ISO14443B mode */
-      st25r200WriteRegister(ST25R200_REG_PROTOCOL, ST25R200_REG_PROTOCOL_om_iso14443b);
-
-      /* Set Tx SOF, EOF and EOF */
-      st25r200ChangeRegisterBits(ST25R200_REG_PROTOCOL_TX2,
-                                 (ST25R200_REG_PROTOCOL_TX2_b_tx_sof_mask | ST25R200_REG_PROTOCOL_TX2_b_tx_eof),
-                                 (ST25R200_REG_PROTOCOL_TX2_b_tx_sof_0_10etu | ST25R200_REG_PROTOCOL_TX2_b_tx_sof_1_2etu | ST25R200_REG_PROTOCOL_TX2_b_tx_eof_10etu));
-
-      /* Set Rx SOF and EOF */
-      st25r200ChangeRegisterBits(ST25R200_REG_PROTOCOL_RX1,
-                                 (ST25R200_REG_PROTOCOL_RX1_b_rx_sof | ST25R200_REG_PROTOCOL_RX1_b_rx_eof),
-                                 (ST25R200_REG_PROTOCOL_RX1_b_rx_eof));
-
-      /* Set the minimum TR1 (excluding start_wait) */
-      st25r200ChangeRegisterBits(ST25R200_REG_PROTOCOL_RX2, ST25R200_REG_PROTOCOL_RX2_tr1_min_len_mask, RFAL_TR1MIN);
-
-
-      /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
-      break;
-
-    /*******************************************************************************/
-    case RFAL_MODE_POLL_B_CTS:
-
-      /* Enable ISO14443B mode */
-      st25r200WriteRegister(ST25R200_REG_PROTOCOL, ST25R200_REG_PROTOCOL_om_iso14443b);
-
-      /* Set Tx SOF and EOF */
-      st25r200ChangeRegisterBits(ST25R200_REG_PROTOCOL_TX2,
-                                 (ST25R200_REG_PROTOCOL_TX2_b_tx_sof_mask | ST25R200_REG_PROTOCOL_TX2_b_tx_eof),
-                                 (ST25R200_REG_PROTOCOL_TX2_b_tx_sof_0_10etu | ST25R200_REG_PROTOCOL_TX2_b_tx_sof_1_2etu | ST25R200_REG_PROTOCOL_TX2_b_tx_eof_10etu));
-
-      /* Set Rx SOF EOF */
-      st25r200ChangeRegisterBits(ST25R200_REG_PROTOCOL_RX1,
-                                 (ST25R200_REG_PROTOCOL_RX1_b_rx_sof | ST25R200_REG_PROTOCOL_RX1_b_rx_eof),
-                                 0x00);
+  /* Retrieve the mode configuration */
+  desc = rfalGetModeDesc(mode);
+  if (desc == NULL) {
+    return ERR_NOT_IMPLEMENTED;
+  }
+  if (!desc->supported) {
+    return ERR_NOTSUPP;
+  }
 
-      /* Set the minimum TR1 (excluding start_wait) */
-      st25r200ChangeRegisterBits(ST25R200_REG_PROTOCOL_RX2, ST25R200_REG_PROTOCOL_RX2_tr1_min_len_mask, RFAL_TR1MIN);
+  /* Keep the bus for the whole mode configuration */
+  ST25R200BusSession session(this);
 
-      /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCB | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
-      break;
+  /* Leave the transceive flags on their defaults */
+  rfalRestoreTransceiveFlags();
 
-    /*******************************************************************************/
-    case RFAL_MODE_POLL_NFCV:
-    case RFAL_MODE_POLL_PICOPASS:
+  /* Queue the mode registers so that they are written together with the analog and bit rate settings */
+  st25r200BatchBegin();
 
-      /* Enable ISO15693 mode */
-      st25r200WriteRegister(ST25R200_REG_PROTOCOL, ST25R200_REG_PROTOCOL_om_iso15693);
+  /* Enable the operation mode */
+  st25r200WriteRegister(ST25R200_REG_PROTOCOL, desc->protocol);
 
-      /* Set Analog configurations for this mode and bit rate */
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
-      rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_POLL | RFAL_ANALOG_CONFIG_TECH_NFCV | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
-      break;
+  /* Set Tx SOF and EOF */
+  if (desc->tx2Mask != 0U) {
+    st25r200ChangeRegisterBits(ST25R200_REG_PROTOCOL_TX2, desc->tx2Mask, desc->tx2Val);
+  }
 
-    /*******************************************************************************/
-    case RFAL_MODE_POLL_NFCF:
-    case RFAL_MODE_POLL_ACTIVE_P2P:
-    case RFAL_MODE_LISTEN_ACTIVE_P2P:
-    case RFAL_MODE_LISTEN_NFCA:
-    case RFAL_MODE_LISTEN_NFCF:
-    case RFAL_MODE_LISTEN_NFCB:
-      return ERR_NOTSUPP;
+  /* Set Rx SOF and EOF */
+  if (desc->rx1Mask != 0U) {
+    st25r200ChangeRegisterBits(ST25R200_REG_PROTOCOL_RX1, desc->rx1Mask, desc->rx1Val);
+  }
 
-    /*******************************************************************************/
-    default:
-      return ERR_NOT_IMPLEMENTED;
+  /* Set the minimum TR1 (excluding start_wait) */
+  if (desc->rx2Mask != 0U) {
+    st25r200ChangeRegisterBits(ST25R200_REG_PROTOCOL_RX2, desc->rx2Mask, desc->rx2Val);
   }
 
+  /* Set Analog configurations for this mode and bit rate */
+  rfalSetAnalogConfig((desc->analogTech | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_TX));
+  rfalSetAnalogConfig((desc->analogTech | RFAL_ANALOG_CONFIG_BITRATE_COMMON | RFAL_ANALOG_CONFIG_RX));
+
   /* Set state as STATE_MODE_SET only if not initialized yet (PSL) */
   gRFAL.state = ((gRFAL.state < RFAL_STATE_MODE_SET) ? RFAL_STATE_MODE_SET : gRFAL.state);
   gRFAL.mode  = mode;
 
   /* Apply the given bit rate */
-  return rfalSetBitRate(txBR, rxBR);
+  ret = rfalSetBitRate(txBR, rxBR);
+
+  /* Write all queued register changes */
+  retCommit = st25r200BatchCommit();
+
+  return ((ret != ERR_NONE) ? ret : retCommit);
 }
 
 
@@ -411,8 +432,15 @@ ReturnCode RfalRfST25R200Class::rfalSetBitRate(rfalBitRate txBR, rfalBitRate rxB
   gRFAL.rxBR = ((rxBR == RFAL_BR_KEEP) ? gRFAL.rxBR : rxBR);
 
 
+  /* Queue the bit rate and analog settings, written at once on commit */
+  st25r200BatchBegin();
+
   /* Set bit rate register */
-  EXIT_ON_ERR(ret, st25r200SetBitrate((uint8_t)rfalConvBitRate(gRFAL.txBR), (uint8_t)rfalConvBitRate(gRFAL.rxBR)));
+  ret = st25r200SetBitrate((uint8_t)rfalConvBitRate(gRFAL.txBR), (uint8_t)rfalConvBitRate(gRFAL.rxBR));
+  if (ret != ERR_NONE) {
+    st25r200BatchCommit();
+    return ret;
+  }
 
 
   switch (gRFAL.mode) {
@@ -455,14 +483,16 @@ ReturnCode RfalRfST25R200Class::rfalSetBitRate(rfalBitRate txBR, rfalBitRate rxB
     case RFAL_MODE_LISTEN_NFCF:
     case RFAL_MODE_LISTEN_NFCB:
     case RFAL_MODE_NONE:
+      st25r200BatchCommit();
       return ERR_WRONG_STATE;
 
     /*******************************************************************************/
     default:
+      st25r200BatchCommit();
       return ERR_NOT_IMPLEMENTED;
   }
 
-  return ERR_NONE;
+  return st25r200BatchCommit();
 }
 
 
@@ -606,7 +636,7 @@ ReturnCode RfalRfST25R200Class::rfalFieldOnAndStartGT(void)
   /* Start GT timer in case the GT value is set */
   if ((gRFAL.timings.GT != RFAL_TIMING_NONE)) {
     /* Ensure that a SW timer doesn't have a lower value then the minimum  */
-    rfalTimerStart(gRFAL.tmr.GT, rfalConv1fcToMs(MAX((gRFAL.timings.GT), RFAL_ST25R200_GT_MIN_1FC)));
+    rfalTimerStartUs(gRFAL.tmr.GT, rfalST25R200Conv1fcToUs(MAX((gRFAL.timings.GT), RFAL_ST25R200_GT_MIN_1FC)));
   }
 
   return ret;
@@ -621,6 +651,9 @@ ReturnCode RfalRfST25R200Class::rfalFieldOff(void)
     rfalCleanupTransceive();
   }
 
+  /* Leave the transceive flags on their defaults */
+  rfalRestoreTransceiveFlags();
+
   /* Disable Tx and Rx */
   st25r200TxRxOff();
 
@@ -636,6 +669,7 @@ ReturnCode RfalRfST25R200Class::rfalFieldOff(void)
 ReturnCode RfalRfST25R200Class::rfalStartTransceive(const rfalTransceiveContext *ctx)
 {
   uint32_t FxTAdj;  /* FWT or FDT adjustment calculation */
+  const rfalModeDesc *desc;
 
   /* Check for valid parameters */
   if (ctx == NULL) {
@@ -652,91 +686,604 @@ ReturnCode RfalRfST25R200Class::rfalStartTransceive(const rfalTransceiveContext
 
     gRFAL.TxRx.ctx = *ctx;
 
+    /* A synchronous transceive drops the completion and stream callbacks of a previous one */
+    gRFAL.TxRx.doneCb    = NULL;
+    gRFAL.TxRx.doneCbCtx = NULL;
+    gRFAL.TxRx.stream.cb = NULL;
+    gRFAL.TxRx.txSeg     = NULL;
+    gRFAL.TxRx.txSegCnt  = 0;
+
+    /* FDT Listen and FWT adjustments of the current mode */
+    desc = rfalGetModeDesc(gRFAL.mode);
+
     /*******************************************************************************/
     if (gRFAL.timings.FDTListen != RFAL_TIMING_NONE) {
       /* Calculate MRT adjustment accordingly to the current mode */
       FxTAdj = RFAL_FDT_LISTEN_MRT_ADJUSTMENT;
-      if (gRFAL.mode == RFAL_MODE_POLL_NFCA)      {
-        FxTAdj += (uint32_t)RFAL_FDT_LISTEN_A_ADJUSTMENT;
-      }
-      if (gRFAL.mode == RFAL_MODE_POLL_NFCA_T1T)  {
-        FxTAdj += (uint32_t)RFAL_FDT_LISTEN_A_ADJUSTMENT;
+      if (desc != NULL) {
+        FxTAdj += (uint32_t)desc->fdtListenAdj;
       }
-      if (gRFAL.mode == RFAL_MODE_POLL_NFCB)      {
-        FxTAdj += (uint32_t)RFAL_FDT_LISTEN_B_ADJUSTMENT;
+
+      /* Set Minimum FDT(Listen) in which PICC is not allowed to send a response */
+      rfalSetMaskReceiveTime((uint8_t)rfalConv1fcTo64fc((FxTAdj > gRFAL.timings.FDTListen) ? RFAL_ST25R200_MRT_MIN_1FC : (gRFAL.timings.FDTListen - FxTAdj)));
+    }
+
+    /*******************************************************************************/
+    /* FDT Poll will be loaded in rfalPrepareTransceive() once the previous was expired */
+
+#if ST25R200_FEATURE_ADAPTIVE_FWT
+    /* Shrink the FWT to the response times learned for this mode and command class */
+    gRFAL.TxRx.ctx.fwt = rfalAdaptiveFwtApply(gRFAL.TxRx.ctx.fwt);
+#endif /* ST25R200_FEATURE_ADAPTIVE_FWT */
+
+    /*******************************************************************************/
+    if ((gRFAL.TxRx.ctx.fwt != RFAL_FWT_NONE) && (gRFAL.TxRx.ctx.fwt != 0U)) {
+      /* Ensure proper timing configuration */
+      if (gRFAL.timings.FDTListen >= gRFAL.TxRx.ctx.fwt) {
+        return ERR_PARAM;
       }
-      if (gRFAL.mode == RFAL_MODE_POLL_NFCV)      {
-        FxTAdj += (uint32_t)RFAL_FDT_LISTEN_V_ADJUSTMENT;
+
+      FxTAdj = RFAL_FWT_ADJUSTMENT;
+      if (desc != NULL) {
+        FxTAdj += (uint32_t)desc->fwtAdj;
       }
 
-      /* Ensure that MRT is using 64/fc steps */
-      st25r200ChangeRegisterBits(ST25R200_REG_MRT_SQT_CONF, ST25R200_REG_MRT_SQT_CONF_mrt_step_mask, ST25R200_REG_MRT_SQT_CONF_mrt_step_64fc);
+      /* Ensure that the given FWT doesn't exceed NRT maximum */
+      gRFAL.TxRx.ctx.fwt = MIN((gRFAL.TxRx.ctx.fwt + FxTAdj), RFAL_ST25R200_NRT_MAX_1FC);
+
+      /* Set FWT in the NRT */
+      st25r200SetNoResponseTime(rfalConv1fcTo64fc(gRFAL.TxRx.ctx.fwt));
+    } else {
+      /* Disable NRT, no NRE will be triggered, therefore wait endlessly for Rx */
+      st25r200SetNoResponseTime(RFAL_ST25R200_NRT_DISABLED);
+    }
+
+    gRFAL.state       = RFAL_STATE_TXRX;
+    gRFAL.TxRx.state  = RFAL_TXRX_STATE_TX_IDLE;
+    gRFAL.TxRx.status = ERR_BUSY;
+    gRFAL.TxRx.preloaded = false;
+    gRFAL.TxRx.attempt   = 1;
+
+
+    /*******************************************************************************/
+    /* Check if the Transceive start performing Tx or goes directly to Rx          */
+    if ((gRFAL.TxRx.ctx.txBuf == NULL) || (gRFAL.TxRx.ctx.txBufLen == 0U)) {
+      /* Clear FIFO, Clear and Enable the Interrupts */
+      rfalPrepareTransceive();
+
+      /* No Tx done, enable the Receiver */
+      st25r200ExecuteCommand(ST25R200_CMD_UNMASK_RECEIVE_DATA);
+
+      /* Start NRT manually, if FWT = 0 (wait endlessly for Rx) chip will ignore anyhow */
+      st25r200ExecuteCommand(ST25R200_CMD_START_NO_RESPONSE_TIMER);
+
+      gRFAL.TxRx.state  = RFAL_TXRX_STATE_RX_IDLE;
+    }
+
+#if ST25R200_FEATURE_PROFILER
+    /* Transceive timing starts now */
+    rfalProfUpdate();
+#endif /* ST25R200_FEATURE_PROFILER */
+
+    return ERR_NONE;
+  }
+
+  return ERR_WRONG_STATE;
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::rfalStartTransceiveAsync(const rfalTransceiveContext *ctx, rfalTransceiveDoneCallback cb, void *cbCtx)
+{
+  ReturnCode            ret;
+  rfalTransceiveContext aCtx;
+
+  if ((ctx == NULL) || (cb == NULL)) {
+    return ERR_PARAM;
+  }
+
+  /* Ensure the received length is always available to the callback */
+  aCtx = *ctx;
+  gRFAL.TxRx.rxLen = 0U;
+  if (aCtx.rxRcvdLen == NULL) {
+    aCtx.rxRcvdLen = &gRFAL.TxRx.rxLen;
+  }
+
+  EXIT_ON_ERR(ret, rfalStartTransceive(&aCtx));
+
+  gRFAL.TxRx.doneCb    = cb;
+  gRFAL.TxRx.doneCbCtx = cbCtx;
+
+  return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::rfalStartTransceiveSg(const rfalTransceiveContext *ctx, const rfalTxSegment *seg, uint8_t segCnt)
+{
+  ReturnCode            ret;
+  rfalTransceiveContext sgCtx;
+  uint32_t              total;
+  uint8_t               i;
+
+  if ((ctx == NULL) || (seg == NULL) || (segCnt == 0U)) {
+    return ERR_PARAM;
+  }
+
+  total = 0;
+  for (i = 0; i < segCnt; i++) {
+    if (seg[i].data == NULL) {
+      return ERR_PARAM;
+    }
+    total += seg[i].len;
+  }
+
+  /* The frame length must fit in txBufLen and be covered by the segments */
+  if ((total == 0U) || (rfalConvBytesToBits(total) > 0xFFFFU) || (ctx->txBufLen > rfalConvBytesToBits(total))) {
+    return ERR_PARAM;
+  }
+
+  /* txBuf only signals that there is something to transmit, the FIFO is filled from the segments */
+  sgCtx          = *ctx;
+  sgCtx.txBuf    = (uint8_t *)seg[0].data;   /*  PRQA S 0311 # MISRA 11.8 - txBuf is only read */
+  sgCtx.txBufLen = ((ctx->txBufLen == 0U) ? (uint16_t)rfalConvBytesToBits(total) : ctx->txBufLen);
+
+  EXIT_ON_ERR(ret, rfalStartTransceive(&sgCtx));
+
+  gRFAL.TxRx.txSeg    = seg;
+  gRFAL.TxRx.txSegCnt = segCnt;
+
+  return ERR_NONE;
+}
+
+
+#if ST25R200_FEATURE_RX_STREAM
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::rfalStartTransceiveStream(const rfalTransceiveContext *ctx, rfalRxStreamCallback cb, void *cbCtx)
+{
+  ReturnCode ret;
+
+  if ((ctx == NULL) || (cb == NULL) || (ctx->rxBuf == NULL) || (rfalConvBitsToBytes(ctx->rxBufLen) < RFAL_RX_STREAM_MIN_LEN)) {
+    return ERR_PARAM;
+  }
+
+  EXIT_ON_ERR(ret, rfalStartTransceive(ctx));
+
+  /* Reception is only started by the worker, the ring buffer is reset on Rx start */
+  gRFAL.TxRx.stream.cb        = cb;
+  gRFAL.TxRx.stream.cbCtx     = cbCtx;
+  gRFAL.TxRx.stream.size      = (uint16_t)rfalConvBitsToBytes(ctx->rxBufLen);
+  gRFAL.TxRx.stream.written   = 0;
+  gRFAL.TxRx.stream.delivered = 0;
+
+  return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+uint16_t RfalRfST25R200Class::rfalRxStreamHold(void)
+{
+  /* The trailing CRC is held back until the end of the frame is known */
+  return (((gRFAL.TxRx.ctx.flags & (uint32_t)RFAL_TXRX_FLAGS_CRC_RX_KEEP) == 0U) ? RFAL_CRC_LEN : 0U);
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalRxStreamDeliver(uint16_t upTo)
+{
+  rfalRxStream *st;
+  uint16_t     pos;
+  uint16_t     len;
+
+  st = &gRFAL.TxRx.stream;
+
+  /* Hand over the ring buffer content in contiguous chunks */
+  while (st->delivered < upTo) {
+    pos = (uint16_t)(st->delivered % st->size);
+    len = MIN((uint16_t)(upTo - st->delivered), (uint16_t)(st->size - pos));
+
+    st->cb(st->cbCtx, &gRFAL.TxRx.ctx.rxBuf[pos], len);
+    st->delivered += len;
+  }
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalRxStreamRead(uint16_t length, uint16_t hold)
+{
+  rfalRxStream *st;
+  uint16_t     pos;
+  uint16_t     len;
+
+  st = &gRFAL.TxRx.stream;
+
+  while (length > 0U) {
+    /* Free the ring buffer, only the held back bytes are kept */
+    if (st->written > hold) {
+      rfalRxStreamDeliver((uint16_t)(st->written - hold));
+    }
+
+    /* Read what fits in the contiguous free space of the ring buffer */
+    pos = (uint16_t)(st->written % st->size);
+    len = MIN(length, (uint16_t)(st->size - (st->written - st->delivered)));
+    len = MIN(len, (uint16_t)(st->size - pos));
+
+    st25r200ReadFifo(&gRFAL.TxRx.ctx.rxBuf[pos], len);
+    st->written += len;
+    length      -= len;
+  }
+
+  if (st->written > hold) {
+    rfalRxStreamDeliver((uint16_t)(st->written - hold));
+  }
+}
+#endif /* ST25R200_FEATURE_RX_STREAM */
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalTransceiveAsyncComplete(void)
+{
+  rfalTransceiveDoneCallback cb;
+
+  if ((gRFAL.TxRx.doneCb == NULL) || (gRFAL.TxRx.state != RFAL_TXRX_STATE_IDLE)) {
+    return;
+  }
+
+  /* Clear the callback first, it may start the next transceive */
+  cb = gRFAL.TxRx.doneCb;
+  gRFAL.TxRx.doneCb = NULL;
+
+  cb(gRFAL.TxRx.doneCbCtx, gRFAL.TxRx.status, *gRFAL.TxRx.ctx.rxRcvdLen);
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::rfalTransceiveQueueAdd(rfalTransceiveQueueEntry *entry)
+{
+  if (entry == NULL) {
+    return ERR_PARAM;
+  }
+
+  if (gRfalTxRxQueue.count >= RFAL_TXRX_QUEUE_LEN) {
+    return ERR_NOMEM;
+  }
+
+  entry->status = ERR_BUSY;
+  entry->rxLen  = 0U;
+
+  gRfalTxRxQueue.entry[(gRfalTxRxQueue.head + gRfalTxRxQueue.count) % RFAL_TXRX_QUEUE_LEN] = entry;
+  gRfalTxRxQueue.count++;
+
+  /* Start right away if nothing is running */
+  rfalTransceiveQueueNext();
+
+  return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+uint8_t RfalRfST25R200Class::rfalTransceiveQueueGetCount(void)
+{
+  return gRfalTxRxQueue.count;
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalTransceiveQueueClear(void)
+{
+  uint8_t first;
+
+  /* The running entry, if any, remains queued until it completes */
+  first = (gRfalTxRxQueue.running ? 1U : 0U);
+
+  while (gRfalTxRxQueue.count > first) {
+    gRfalTxRxQueue.count--;
+    gRfalTxRxQueue.entry[(gRfalTxRxQueue.head + gRfalTxRxQueue.count) % RFAL_TXRX_QUEUE_LEN]->status = ERR_REQUEST;
+  }
+
+  /* A running entry whose transceive has been superseded will never complete */
+  if ((first != 0U) && (gRFAL.TxRx.doneCb != &RfalRfST25R200Class::rfalTransceiveQueueDone)) {
+    gRfalTxRxQueue.entry[gRfalTxRxQueue.head]->status = ERR_REQUEST;
+    gRfalTxRxQueue.count   = 0U;
+    gRfalTxRxQueue.running = false;
+  }
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalTransceiveQueueNext(void)
+{
+  rfalTransceiveQueueEntry *entry;
+  ReturnCode               ret;
+
+  /* Start the next entry unless one is running or another transceive is ongoing */
+  while ((!gRfalTxRxQueue.running) && (gRfalTxRxQueue.count > 0U)) {
+    if ((gRFAL.TxRx.state != RFAL_TXRX_STATE_IDLE) || (gRFAL.TxRx.doneCb != NULL)) {
+      return;
+    }
+
+    entry = gRfalTxRxQueue.entry[gRfalTxRxQueue.head];
+
+    ret = rfalStartTransceiveAsync(&entry->ctx, &RfalRfST25R200Class::rfalTransceiveQueueDone, this);
+    if (ret == ERR_NONE) {
+      gRfalTxRxQueue.running = true;
+      return;
+    }
+
+    /* Entry could not be started, complete it and go on with the next one */
+    entry->status = ret;
+    gRfalTxRxQueue.head = (uint8_t)((gRfalTxRxQueue.head + 1U) % RFAL_TXRX_QUEUE_LEN);
+    gRfalTxRxQueue.count--;
+  }
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalTransceiveQueueDone(void *cbCtx, ReturnCode status, uint16_t rxLen)
+{
+  RfalRfST25R200Class      *rf;
+  rfalTransceiveQueueEntry *entry;
+
+  rf = (RfalRfST25R200Class *)cbCtx;
+
+  /* Store the result of the head entry and remove it from the queue */
+  entry = rf->gRfalTxRxQueue.entry[rf->gRfalTxRxQueue.head];
+  entry->rxLen  = rxLen;
+  entry->status = status;
+
+  rf->gRfalTxRxQueue.head = (uint8_t)((rf->gRfalTxRxQueue.head + 1U) % RFAL_TXRX_QUEUE_LEN);
+  rf->gRfalTxRxQueue.count--;
+  rf->gRfalTxRxQueue.running = false;
+
+  /* Chain the next frame within the same worker run */
+  rf->rfalTransceiveQueueNext();
+}
+
+
+#if ST25R200_FEATURE_PROFILER
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalProfReset(void)
+{
+  memset(&gRfalProf, 0, sizeof(rfalProfiler));
+  gRfalProf.curState = gRFAL.TxRx.state;
+  gRfalProf.stateTs  = timerGetTimeUs();
+  gRfalProf.txrxTs   = gRfalProf.stateTs;
+}
+
+
+/*******************************************************************************/
+const rfalProfStat *RfalRfST25R200Class::rfalProfGetStateStat(rfalTransceiveState state)
+{
+  return rfalProfStateStat(state);
+}
+
+
+/*******************************************************************************/
+rfalProfStat *RfalRfST25R200Class::rfalProfStateStat(rfalTransceiveState state)
+{
+  uint32_t st;
+
+  st = (uint32_t)state;
+
+  if ((st >= (uint32_t)RFAL_TXRX_STATE_TX_IDLE) && (st < ((uint32_t)RFAL_TXRX_STATE_TX_IDLE + RFAL_PROF_TX_STATES))) {
+    return &gRfalProf.state[st - (uint32_t)RFAL_TXRX_STATE_TX_IDLE];
+  }
+
+  if ((st >= (uint32_t)RFAL_TXRX_STATE_RX_IDLE) && (st < ((uint32_t)RFAL_TXRX_STATE_RX_IDLE + RFAL_PROF_RX_STATES))) {
+    return &gRfalProf.state[RFAL_PROF_TX_STATES + (st - (uint32_t)RFAL_TXRX_STATE_RX_IDLE)];
+  }
+
+  return NULL;
+}
+
+
+/*******************************************************************************/
+const rfalProfStat *RfalRfST25R200Class::rfalProfGetModeStat(rfalMode mode)
+{
+  return (((uint32_t)mode < RFAL_PROF_MODES) ? &gRfalProf.mode[(uint32_t)mode] : NULL);
+}
+
+
+/*******************************************************************************/
+const rfalProfStat *RfalRfST25R200Class::rfalProfGetIrqStat(void)
+{
+  return &gRfalProf.irq;
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalProfSample(rfalProfStat *stat, uint32_t us)
+{
+  uint8_t bin;
+
+  if ((stat->count == 0U) || (us < stat->min)) {
+    stat->min = us;
+  }
+  if (us > stat->max) {
+    stat->max = us;
+  }
+  stat->count++;
+  stat->sum += us;
+
+  bin = 0;
+  while ((bin < (RFAL_PROF_HIST_BINS - 1U)) && ((us >> bin) != 0U)) {
+    bin++;
+  }
+  if (stat->hist[bin] < 0xFFFFU) {
+    stat->hist[bin]++;
+  }
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalProfUpdate(void)
+{
+  rfalProfStat *stat;
+  uint32_t     now;
+
+  if (gRFAL.TxRx.state == gRfalProf.curState) {
+    return;
+  }
+
+  now = timerGetTimeUs();
+
+  /* Time spent in the state just left */
+  stat = rfalProfStateStat(gRfalProf.curState);
+  if (stat != NULL) {
+    rfalProfSample(stat, (now - gRfalProf.stateTs));
+  }
+
+  /* Back to idle: the transceive is over, leaving idle: a new one starts */
+  if (gRFAL.TxRx.state == RFAL_TXRX_STATE_IDLE) {
+    if ((uint32_t)gRFAL.mode < RFAL_PROF_MODES) {
+      rfalProfSample(&gRfalProf.mode[(uint32_t)gRFAL.mode], (now - gRfalProf.txrxTs));
+    }
+  } else if (gRfalProf.curState == RFAL_TXRX_STATE_IDLE) {
+    gRfalProf.txrxTs = now;
+  } else {
+    /* MISRA 15.7 - Empty else */
+  }
+
+  gRfalProf.curState = gRFAL.TxRx.state;
+  gRfalProf.stateTs  = now;
+}
+#endif /* ST25R200_FEATURE_PROFILER */
+
+
+#if ST25R200_FEATURE_ADAPTIVE_FWT
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalAdaptiveFwtEnable(bool enable)
+{
+  gRfalAfwt.enabled = enable;
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::rfalAdaptiveFwtSetClass(uint8_t cls)
+{
+  if (cls >= RFAL_AFWT_CLASSES) {
+    return ERR_PARAM;
+  }
+
+  gRfalAfwt.cls = cls;
+  return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalAdaptiveFwtReset(void)
+{
+  gRfalAfwt.cur = NULL;
+  memset(gRfalAfwt.entry, 0, sizeof(gRfalAfwt.entry));
+}
+
+
+/*******************************************************************************/
+uint32_t RfalRfST25R200Class::rfalAdaptiveFwtGet(rfalMode mode, uint8_t cls)
+{
+  const rfalAdaptiveFwtEntry *e;
+
+  if (((uint32_t)mode >= RFAL_AFWT_MODES) || (cls >= RFAL_AFWT_CLASSES)) {
+    return 0U;
+  }
+
+  e = &gRfalAfwt.entry[(uint32_t)mode][cls];
+  return ((e->samples >= RFAL_AFWT_MIN_SAMPLES) ? e->resp : 0U);
+}
+
+
+/*******************************************************************************/
+uint32_t RfalRfST25R200Class::rfalAdaptiveFwtApply(uint32_t fwt)
+{
+  rfalAdaptiveFwtEntry *e;
+  uint32_t             learned;
 
-      /* Set Minimum FDT(Listen) in which PICC is not allowed to send a response */
-      st25r200WriteRegister(ST25R200_REG_MRT, (uint8_t)rfalConv1fcTo64fc((FxTAdj > gRFAL.timings.FDTListen) ? RFAL_ST25R200_MRT_MIN_1FC : (gRFAL.timings.FDTListen - FxTAdj)));
-    }
+  gRfalAfwt.cur    = NULL;
+  gRfalAfwt.shrunk = false;
+  gRfalAfwt.seen   = ST25R200_IRQ_MASK_NONE;
 
-    /*******************************************************************************/
-    /* FDT Poll will be loaded in rfalPrepareTransceive() once the previous was expired */
+  if ((!gRfalAfwt.enabled) || ((uint32_t)gRFAL.mode >= RFAL_AFWT_MODES)) {
+    return fwt;
+  }
 
-    /*******************************************************************************/
-    if ((gRFAL.TxRx.ctx.fwt != RFAL_FWT_NONE) && (gRFAL.TxRx.ctx.fwt != 0U)) {
-      /* Ensure proper timing configuration */
-      if (gRFAL.timings.FDTListen >= gRFAL.TxRx.ctx.fwt) {
-        return ERR_PARAM;
-      }
+  e = &gRfalAfwt.entry[(uint32_t)gRFAL.mode][gRfalAfwt.cls];
+  gRfalAfwt.cur = e;
 
-      FxTAdj = RFAL_FWT_ADJUSTMENT;
-      if (gRFAL.mode == RFAL_MODE_POLL_NFCA)      {
-        FxTAdj += (uint32_t)RFAL_FWT_A_ADJUSTMENT;
-      }
-      if (gRFAL.mode == RFAL_MODE_POLL_NFCA_T1T)  {
-        FxTAdj += (uint32_t)RFAL_FWT_A_ADJUSTMENT;
-      }
-      if (gRFAL.mode == RFAL_MODE_POLL_NFCB)      {
-        FxTAdj += (uint32_t)RFAL_FWT_B_ADJUSTMENT;
-      }
-      if (gRFAL.mode == RFAL_MODE_POLL_NFCV)      {
-        FxTAdj += (uint32_t)RFAL_FWT_V_ADJUSTMENT;
-      }
+  /* Use the given FWT until enough responses are learned */
+  if ((fwt == RFAL_FWT_NONE) || (fwt == 0U) || (e->samples < RFAL_AFWT_MIN_SAMPLES)) {
+    return fwt;
+  }
 
-      /* Ensure that the given FWT doesn't exceed NRT maximum */
-      gRFAL.TxRx.ctx.fwt = MIN((gRFAL.TxRx.ctx.fwt + FxTAdj), RFAL_ST25R200_NRT_MAX_1FC);
+  learned = (e->resp + (e->resp >> 1U) + RFAL_AFWT_MARGIN_1FC);
 
-      /* Set FWT in the NRT */
-      st25r200SetNoResponseTime(rfalConv1fcTo64fc(gRFAL.TxRx.ctx.fwt));
-    } else {
-      /* Disable NRT, no NRE will be triggered, therefore wait endlessly for Rx */
-      st25r200SetNoResponseTime(RFAL_ST25R200_NRT_DISABLED);
-    }
+  /* The response may not be expected before FDT Listen */
+  if ((gRFAL.timings.FDTListen != RFAL_TIMING_NONE) && (learned <= gRFAL.timings.FDTListen)) {
+    learned = (gRFAL.timings.FDTListen + RFAL_AFWT_MARGIN_1FC);
+  }
 
-    gRFAL.state       = RFAL_STATE_TXRX;
-    gRFAL.TxRx.state  = RFAL_TXRX_STATE_TX_IDLE;
-    gRFAL.TxRx.status = ERR_BUSY;
+  if (learned >= fwt) {
+    return fwt;
+  }
 
+  gRfalAfwt.shrunk = true;
+  return learned;
+}
 
-    /*******************************************************************************/
-    /* Check if the Transceive start performing Tx or goes directly to Rx          */
-    if ((gRFAL.TxRx.ctx.txBuf == NULL) || (gRFAL.TxRx.ctx.txBufLen == 0U)) {
-      /* Clear FIFO, Clear and Enable the Interrupts */
-      rfalPrepareTransceive();
 
-      /* No Tx done, enable the Receiver */
-      st25r200ExecuteCommand(ST25R200_CMD_UNMASK_RECEIVE_DATA);
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalAdaptiveFwtIrq(uint32_t irqs, uint32_t ts)
+{
+  if (gRfalAfwt.cur == NULL) {
+    return;
+  }
 
-      /* Start NRT manually, if FWT = 0 (wait endlessly for Rx) chip will ignore anyhow */
-      st25r200ExecuteCommand(ST25R200_CMD_START_NO_RESPONSE_TIMER);
+  /* RXS latched together with TXE gives no usable response time */
+  if (((irqs & ST25R200_IRQ_MASK_RXS) != 0U) && ((gRfalAfwt.seen & (ST25R200_IRQ_MASK_TXE | ST25R200_IRQ_MASK_RXS)) == ST25R200_IRQ_MASK_TXE)) {
+    gRfalAfwt.rxsTs = ts;
+    gRfalAfwt.seen |= ST25R200_IRQ_MASK_RXS;
+  }
 
-      gRFAL.TxRx.state  = RFAL_TXRX_STATE_RX_IDLE;
-    }
+  if ((irqs & ST25R200_IRQ_MASK_TXE) != 0U) {
+    gRfalAfwt.txeTs = ts;
+    gRfalAfwt.seen |= ST25R200_IRQ_MASK_TXE;
+  }
+}
 
-    return ERR_NONE;
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalAdaptiveFwtLearn(void)
+{
+  rfalAdaptiveFwtEntry *e;
+  uint32_t             resp;
+
+  e = gRfalAfwt.cur;
+  gRfalAfwt.cur = NULL;
+
+  if (e == NULL) {
+    return;
   }
 
-  return ERR_WRONG_STATE;
+  if ((gRfalAfwt.seen & ST25R200_IRQ_MASK_RXS) != 0U) {
+    /* Track a decaying maximum, i.e. a high percentile of the recent response times */
+    resp     = rfalST25R200Conv1usTo1fc(gRfalAfwt.rxsTs - gRfalAfwt.txeTs);
+    e->resp -= (e->resp >> RFAL_AFWT_DECAY_SHIFT);
+    e->resp  = MAX(e->resp, resp);
+
+    if (e->samples < 0xFFU) {
+      e->samples++;
+    }
+  } else if (gRfalAfwt.shrunk && (gRFAL.TxRx.status == ERR_TIMEOUT)) {
+    /* The tag may just be slower than learned: use the given FWT until responses are learned again */
+    e->samples = 0U;
+  } else {
+    /* MISRA 15.7 - Empty else */
+  }
 }
 
 
+#endif /* ST25R200_FEATURE_ADAPTIVE_FWT */
+
+
 /*******************************************************************************/
 bool RfalRfST25R200Class::rfalIsTransceiveInTx(void)
 {
@@ -817,13 +1364,27 @@ ReturnCode RfalRfST25R200Class::rfalTransceiveBlockingTxRx(uint8_t *txBuf, uint1
 ReturnCode RfalRfST25R200Class::rfalRunTransceiveWorker(void)
 {
   if (gRFAL.state == RFAL_STATE_TXRX) {
+    /* Keep the bus for all the accesses of this worker run */
+    ST25R200BusSession session(this);
+
+#if ST25R200_FEATURE_PROFILER
+    /* Account the time elapsed since the last run to the state it was left in */
+    rfalProfUpdate();
+#endif /* ST25R200_FEATURE_PROFILER */
+
     /* Run Tx or Rx state machines */
     if (rfalIsTransceiveInTx()) {
       rfalTransceiveTx();
+#if ST25R200_FEATURE_PROFILER
+      rfalProfUpdate();
+#endif /* ST25R200_FEATURE_PROFILER */
       return rfalGetTransceiveStatus();
     }
     if (rfalIsTransceiveInRx()) {
       rfalTransceiveRx();
+#if ST25R200_FEATURE_PROFILER
+      rfalProfUpdate();
+#endif /* ST25R200_FEATURE_PROFILER */
       return rfalGetTransceiveStatus();
     }
   }
@@ -831,6 +1392,84 @@ ReturnCode RfalRfST25R200Class::rfalRunTransceiveWorker(void)
 }
 
 
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalSetTransceiveRetryPolicy(const rfalTransceiveRetryPolicy *policy)
+{
+  if (policy == NULL) {
+    gRFAL.TxRx.retry.maxAttempts = 0;
+    return;
+  }
+
+  gRFAL.TxRx.retry = *policy;
+}
+
+
+/*******************************************************************************/
+uint8_t RfalRfST25R200Class::rfalGetTransceiveAttempts(void)
+{
+  return gRFAL.TxRx.attempt;
+}
+
+
+/*******************************************************************************/
+bool RfalRfST25R200Class::rfalTransceiveRetry(void)
+{
+  uint8_t err;
+
+  if ((gRFAL.TxRx.attempt >= gRFAL.TxRx.retry.maxAttempts) || (gRFAL.TxRx.ctx.txBuf == NULL) || (gRFAL.TxRx.ctx.txBufLen == 0U)) {
+    return false;
+  }
+
+  /* Data already handed to a stream consumer cannot be taken back */
+  if (gRFAL.TxRx.stream.cb != NULL) {
+    return false;
+  }
+
+  switch (gRFAL.TxRx.status) {
+    case ERR_TIMEOUT:
+      err = RFAL_TXRX_RETRY_TIMEOUT;
+      break;
+    case ERR_CRC:
+      err = RFAL_TXRX_RETRY_CRC;
+      break;
+    case ERR_FRAMING:
+      err = RFAL_TXRX_RETRY_FRAMING;
+      break;
+    case ERR_PAR:
+      err = RFAL_TXRX_RETRY_PAR;
+      break;
+    case ERR_RF_COLLISION:
+      err = RFAL_TXRX_RETRY_COLLISION;
+      break;
+    default:
+      err = 0U;
+      break;
+  }
+
+  if ((gRFAL.TxRx.retry.errors & err) == 0U) {
+    return false;
+  }
+
+  /* The FIFO is drained by the transmission: the frame is loaded again, timings *
+   * and transceive flags programmed by rfalStartTransceive() are kept           */
+  gRFAL.TxRx.attempt++;
+  gRFAL.TxRx.status    = ERR_BUSY;
+  gRFAL.TxRx.preloaded = false;
+  gRFAL.TxRx.state     = RFAL_TXRX_STATE_TX_IDLE;
+
+#if ST25R200_FEATURE_ADAPTIVE_FWT
+  gRfalAfwt.seen = ST25R200_IRQ_MASK_NONE;
+#endif /* ST25R200_FEATURE_ADAPTIVE_FWT */
+
+  /* Inter-attempt delay, waited as a guard time */
+  if (gRFAL.TxRx.retry.delayUs != 0U) {
+    rfalTimerStartUs(gRFAL.tmr.GT, gRFAL.TxRx.retry.delayUs);
+  }
+
+  return true;
+}
+
+
 /*******************************************************************************/
 rfalTransceiveState RfalRfST25R200Class::rfalGetTransceiveState(void)
 {
@@ -875,6 +1514,9 @@ void RfalRfST25R200Class::rfalWorker(void)
   st25r200CheckForReceivedInterrupts();
 #endif /* ST25R_POLL_IRQ */
 
+  /* Retrieve the interrupts signalled to the deferred IRQ handler */
+  st25r200IrqEvtProcess();
+
   switch (gRFAL.state) {
     case RFAL_STATE_TXRX:
       rfalRunTransceiveWorker();
@@ -892,6 +1534,15 @@ void RfalRfST25R200Class::rfalWorker(void)
       break;
   }
 
+  /* Notify the completion of an asynchronous transceive */
+  rfalTransceiveAsyncComplete();
+
+  /* Put in use an Analog Configuration table loaded meanwhile */
+  rfalAnalogConfigSwap();
+
+  /* Start queued transceives once the ongoing one, if any, has completed */
+  rfalTransceiveQueueNext();
+
   // platformUnprotectWorker();             /* Unprotect RFAL Worker/Task/Process */
 }
 
@@ -948,8 +1599,9 @@ void RfalRfST25R200Class::rfalErrorHandling(void)
       }
 
       rfalFIFOStatusClear();
-      gRFAL.fifo.bytesTotal = 0;
-      gRFAL.TxRx.status     = ERR_BUSY;
+      gRFAL.fifo.bytesTotal     = 0;
+      gRFAL.fifo.bytesHarvested = 0;
+      gRFAL.TxRx.status         = ERR_BUSY;
       gRFAL.TxRx.state      = RFAL_TXRX_STATE_RX_WAIT_RXS;
     }
     return;
@@ -967,7 +1619,10 @@ void RfalRfST25R200Class::rfalErrorHandling(void)
     /*******************************************************************************/
     if ((gRFAL.TxRx.status == ERR_PAR) || (gRFAL.TxRx.status == ERR_CRC)) {
       if ((rfalFIFOStatusIsIncompleteByte()) && (fifoBytesToRead == RFAL_RX_INC_BYTE_LEN)) {
-        st25r200ReadFifo((uint8_t *)(gRFAL.TxRx.ctx.rxBuf), fifoBytesToRead);
+        /* The byte may have already been retrieved at RXE */
+        if (gRFAL.fifo.bytesHarvested < fifoBytesToRead) {
+          st25r200ReadFifo((uint8_t *)(gRFAL.TxRx.ctx.rxBuf), fifoBytesToRead);
+        }
         if ((gRFAL.TxRx.ctx.rxRcvdLen) != NULL) {
           *gRFAL.TxRx.ctx.rxRcvdLen = rfalFIFOGetNumIncompleteBits();
         }
@@ -980,6 +1635,24 @@ void RfalRfST25R200Class::rfalErrorHandling(void)
 }
 
 
+/*******************************************************************************/
+bool RfalRfST25R200Class::rfalTransceiveFifoBusy(rfalTransceiveState failState)
+{
+  if (st25r200FifoXferIsBusy()) {
+    return true;
+  }
+
+  /* A FIFO transfer aborted on timeout leaves the frame incomplete */
+  if (st25r200FifoXferWait() != ERR_NONE) {
+    gRFAL.TxRx.status = ERR_IO;
+    gRFAL.TxRx.state  = failState;
+    return true;
+  }
+
+  return false;
+}
+
+
 /*******************************************************************************/
 void RfalRfST25R200Class::rfalCleanupTransceive(void)
 {
@@ -987,14 +1660,14 @@ void RfalRfST25R200Class::rfalCleanupTransceive(void)
   /* Transceive flags                                                            */
   /*******************************************************************************/
 
-  /* Restore default settings on Tx Parity and CRC */
-  st25r200SetRegisterBits(ST25R200_REG_PROTOCOL_TX1, (ST25R200_REG_PROTOCOL_TX1_a_tx_par | ST25R200_REG_PROTOCOL_TX1_tx_crc));
-
-  /* Restore default settings on Receiving parity + CRC bits */
-  st25r200SetRegisterBits(ST25R200_REG_PROTOCOL_RX1, (ST25R200_REG_PROTOCOL_RX1_a_rx_par | ST25R200_REG_PROTOCOL_RX1_rx_crc));
+  /* Default Tx/Rx Parity and CRC and AGC settings are restored once leaving transceive *
+   * operation, consecutive transceives with the same flags leave the registers as is   */
+  gRFAL.txrxFlagsRestore = true;
 
-  /* Restore AGC enabled */
-  st25r200SetRegisterBits(ST25R200_REG_RX_DIG, ST25R200_REG_RX_DIG_agc_en);
+#if ST25R200_FEATURE_ADAPTIVE_FWT
+  /* Learn the response time of this transceive */
+  rfalAdaptiveFwtLearn();
+#endif /* ST25R200_FEATURE_ADAPTIVE_FWT */
 
   /*******************************************************************************/
   /* Execute Post Transceive Callback                                            */
@@ -1007,18 +1680,52 @@ void RfalRfST25R200Class::rfalCleanupTransceive(void)
 
 
 /*******************************************************************************/
-void RfalRfST25R200Class::rfalPrepareTransceive(void)
+void RfalRfST25R200Class::rfalApplyTransceiveFlags(uint8_t tx1, uint8_t rx1, uint8_t rxDig, uint8_t nrtGpt)
 {
-  uint32_t maskInterrupts;
-  uint32_t clrMaskInterrupts;
-  uint8_t  reg;
+  /* Consecutive transceives with the same flags leave the registers untouched */
+  st25r200UpdateRegisterBits(ST25R200_REG_PROTOCOL_TX1, RFAL_TXRX_FLAGS_TX1_MASK, tx1);
+  st25r200UpdateRegisterBits(ST25R200_REG_PROTOCOL_RX1, RFAL_TXRX_FLAGS_RX1_MASK, rx1);
+  st25r200UpdateRegisterBits(ST25R200_REG_RX_DIG, ST25R200_REG_RX_DIG_agc_en, rxDig);
+  st25r200UpdateRegisterBits(ST25R200_REG_NRT_GPT_CONF, ST25R200_REG_NRT_GPT_CONF_nrt_emd, nrtGpt);
+
+  gRFAL.txrxFlagsRestore = false;
+}
 
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalRestoreTransceiveFlags(void)
+{
+  if (!gRFAL.txrxFlagsRestore) {
+    return;
+  }
+
+  /* Restore default settings on Tx/Rx Parity and CRC and AGC enabled, EMD left as is */
+  st25r200UpdateRegisterBits(ST25R200_REG_PROTOCOL_TX1, RFAL_TXRX_FLAGS_TX1_MASK, RFAL_TXRX_FLAGS_TX1_MASK);
+  st25r200UpdateRegisterBits(ST25R200_REG_PROTOCOL_RX1, RFAL_TXRX_FLAGS_RX1_MASK, RFAL_TXRX_FLAGS_RX1_MASK);
+  st25r200UpdateRegisterBits(ST25R200_REG_RX_DIG, ST25R200_REG_RX_DIG_agc_en, ST25R200_REG_RX_DIG_agc_en);
+
+  gRFAL.txrxFlagsRestore = false;
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalPrepareTransceive(void)
+{
   /* Reset receive logic with STOP command */
   st25r200ExecuteCommand(ST25R200_CMD_STOP);
 
   /* Reset Rx Gain */
   st25r200ExecuteCommand(ST25R200_CMD_CLEAR_RXGAIN);
 
+  rfalPrepareFDTPoll();
+
+  rfalPrepareTransceiveFlags();
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalPrepareFDTPoll(void)
+{
   /*******************************************************************************/
   /* FDT Poll                                                                    */
   /*******************************************************************************/
@@ -1027,6 +1734,19 @@ void RfalRfST25R200Class::rfalPrepareTransceive(void)
     /* Configure GPT to start at RX end */
     st25r200SetStartGPTimer((uint16_t)rfalConv1fcTo8fc(((gRFAL.timings.FDTPoll < RFAL_FDT_POLL_ADJUSTMENT) ? gRFAL.timings.FDTPoll : (gRFAL.timings.FDTPoll - RFAL_FDT_POLL_ADJUSTMENT))), ST25R200_REG_NRT_GPT_CONF_gptc_erx);
   }
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalPrepareTransceiveFlags(void)
+{
+  uint32_t maskInterrupts;
+  uint32_t clrMaskInterrupts;
+  uint8_t  reg;
+  uint8_t  tx1;
+  uint8_t  rx1;
+  uint8_t  rxDig;
+  uint8_t  nrtGpt;
 
   /*******************************************************************************/
   /* Execute Pre Transceive Callback                                             */
@@ -1063,8 +1783,8 @@ void RfalRfST25R200Class::rfalPrepareTransceive(void)
     reg &= ~ST25R200_REG_PROTOCOL_TX1_tx_crc;
   }
 
-  /* Apply current TxRx flags on Tx Register */
-  st25r200ChangeRegisterBits(ST25R200_REG_PROTOCOL_TX1, (ST25R200_REG_PROTOCOL_TX1_tx_crc | ST25R200_REG_PROTOCOL_TX1_a_tx_par), reg);
+  /* Tx Register flags applied below with the other ones */
+  tx1 = reg;
 
 
   /* Check if NFCIP1 mode is to be enabled */
@@ -1086,16 +1806,12 @@ void RfalRfST25R200Class::rfalPrepareTransceive(void)
     reg &= ~ST25R200_REG_PROTOCOL_RX1_rx_crc;
   }
 
-  /* Apply current TxRx flags on Tx Register */
-  st25r200ChangeRegisterBits(ST25R200_REG_PROTOCOL_RX1, (ST25R200_REG_PROTOCOL_RX1_a_rx_par | ST25R200_REG_PROTOCOL_RX1_rx_crc), reg);
+  /* Rx Register flags applied below with the other ones */
+  rx1 = reg;
 
 
   /* Check if AGC is to be disabled */
-  if ((gRFAL.TxRx.ctx.flags & (uint8_t)RFAL_TXRX_FLAGS_AGC_OFF) != 0U) {
-    st25r200ClrRegisterBits(ST25R200_REG_RX_DIG, ST25R200_REG_RX_DIG_agc_en);
-  } else {
-    st25r200SetRegisterBits(ST25R200_REG_RX_DIG, ST25R200_REG_RX_DIG_agc_en);
-  }
+  rxDig = (((gRFAL.TxRx.ctx.flags & (uint8_t)RFAL_TXRX_FLAGS_AGC_OFF) != 0U) ? 0x00U : ST25R200_REG_RX_DIG_agc_en);
   /*******************************************************************************/
 
 
@@ -1103,13 +1819,16 @@ void RfalRfST25R200Class::rfalPrepareTransceive(void)
   /* EMD NRT mode                                                              */
   /*******************************************************************************/
   if (gRFAL.conf.eHandling == ERRORHANDLING_EMD) {
-    st25r200SetRegisterBits(ST25R200_REG_NRT_GPT_CONF, ST25R200_REG_NRT_GPT_CONF_nrt_emd);
+    nrtGpt = ST25R200_REG_NRT_GPT_CONF_nrt_emd;
     maskInterrupts |= ST25R200_IRQ_MASK_RX_REST;
   } else {
-    st25r200ClrRegisterBits(ST25R200_REG_NRT_GPT_CONF, ST25R200_REG_NRT_GPT_CONF_nrt_emd);
+    nrtGpt = 0x00U;
   }
   /*******************************************************************************/
 
+  /* Apply current TxRx flags, only registers whose bits change are accessed */
+  rfalApplyTransceiveFlags(tx1, rx1, rxDig, nrtGpt);
+
 
   /*******************************************************************************/
   /* Clear and enable these interrupts */
@@ -1121,6 +1840,92 @@ void RfalRfST25R200Class::rfalPrepareTransceive(void)
 }
 
 
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalTransceiveTxLoad(bool overlapFdt)
+{
+  if (overlapFdt) {
+    /* STOP would also stop the GPT measuring FDT Poll: only clear the FIFO, *
+     * FDT Poll for the response is set up once the frame is transmitted     */
+    st25r200ExecuteCommand(ST25R200_CMD_CLEAR_FIFO);
+    st25r200ExecuteCommand(ST25R200_CMD_CLEAR_RXGAIN);
+    rfalPrepareTransceiveFlags();
+  } else {
+    /* Clear FIFO, Clear and Enable the Interrupts */
+    rfalPrepareTransceive();
+  }
+
+  /* ST25R200 has a fixed FIFO water level */
+  gRFAL.fifo.expWL = RFAL_FIFO_OUT_WL;
+
+  /* Calculate the bytes needed to be Written into FIFO (a incomplete byte will be added as 1byte) */
+  gRFAL.fifo.bytesTotal = (uint16_t)rfalCalcNumBytes(gRFAL.TxRx.ctx.txBufLen);
+
+  /* Set the number of full bytes and bits to be transmitted */
+  st25r200SetNumTxBits(gRFAL.TxRx.ctx.txBufLen);
+
+  /* Load FIFO with total length or FIFO's maximum */
+  gRFAL.fifo.bytesWritten = MIN(gRFAL.fifo.bytesTotal, ST25R200_FIFO_DEPTH);
+  rfalTransceiveTxWrite(0, gRFAL.fifo.bytesWritten);
+
+  /*Check if Observation Mode is enabled and set it on ST25R391x */
+  rfalCheckEnableObsModeTx();
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalSetMaskReceiveTime(uint8_t mrt)
+{
+  /* Ensure that MRT is using 64/fc steps, identical timings across frames (e.g. inventory, presence check) need no bus access */
+  st25r200UpdateRegisterBits(ST25R200_REG_MRT_SQT_CONF, ST25R200_REG_MRT_SQT_CONF_mrt_step_mask, ST25R200_REG_MRT_SQT_CONF_mrt_step_64fc);
+  st25r200UpdateRegisterBits(ST25R200_REG_MRT, 0xFFU, mrt);
+}
+
+
+/*******************************************************************************/
+const rfalModeDesc *RfalRfST25R200Class::rfalGetModeDesc(rfalMode mode)
+{
+  uint32_t idx;
+
+  idx = ((uint32_t)mode - (uint32_t)RFAL_MODE_POLL_NFCA);
+
+  /* Modes out of the table (RFAL_MODE_NONE wraps around) are not implemented */
+  if ((idx >= SIZEOF_ARRAY(rfalModeDescTbl)) || (rfalModeDescTbl[idx].mode != mode)) {
+    return NULL;
+  }
+
+  return &rfalModeDescTbl[idx];
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalTransceiveTxWrite(uint16_t offset, uint16_t length)
+{
+  const rfalTxSegment *seg;
+  uint16_t            len;
+  uint8_t             i;
+
+  if (gRFAL.TxRx.txSeg == NULL) {
+    st25r200WriteFifoStart(&gRFAL.TxRx.ctx.txBuf[offset], length);
+    return;
+  }
+
+  /* Walk the segments, a FIFO load may start or end anywhere within a segment */
+  for (i = 0; ((i < gRFAL.TxRx.txSegCnt) && (length > 0U)); i++) {
+    seg = &gRFAL.TxRx.txSeg[i];
+
+    if (offset >= seg->len) {
+      offset -= seg->len;
+    } else {
+      len = MIN(length, (uint16_t)(seg->len - offset));
+      st25r200WriteFifoStart(&seg->data[offset], len);
+
+      length -= len;
+      offset  = 0;
+    }
+  }
+}
+
+
 /*******************************************************************************/
 void RfalRfST25R200Class::rfalTransceiveTx(void)
 {
@@ -1163,6 +1968,13 @@ void RfalRfST25R200Class::rfalTransceiveTx(void)
 
       /* In Passive communications GPT is used to measure FDT Poll */
       if (st25r200IsGPTRunning()) {
+#if ST25R200_FEATURE_TX_PRELOAD
+        /* Prepare the frame while FDT Poll elapses, only the transmission is left once it expires */
+        if (!gRFAL.TxRx.preloaded) {
+          rfalTransceiveTxLoad(true);
+          gRFAL.TxRx.preloaded = true;
+        }
+#endif /* ST25R200_FEATURE_TX_PRELOAD */
         break;
       }
 
@@ -1172,24 +1984,10 @@ void RfalRfST25R200Class::rfalTransceiveTx(void)
     /*******************************************************************************/
     case RFAL_TXRX_STATE_TX_PREP_TX:   /*  PRQA S 2003 # MISRA 16.3 - Intentional fall through */
 
-      /* Clear FIFO, Clear and Enable the Interrupts */
-      rfalPrepareTransceive();
-
-      /* ST25R200 has a fixed FIFO water level */
-      gRFAL.fifo.expWL = RFAL_FIFO_OUT_WL;
-
-      /* Calculate the bytes needed to be Written into FIFO (a incomplete byte will be added as 1byte) */
-      gRFAL.fifo.bytesTotal = (uint16_t)rfalCalcNumBytes(gRFAL.TxRx.ctx.txBufLen);
-
-      /* Set the number of full bytes and bits to be transmitted */
-      st25r200SetNumTxBits(gRFAL.TxRx.ctx.txBufLen);
-
-      /* Load FIFO with total length or FIFO's maximum */
-      gRFAL.fifo.bytesWritten = MIN(gRFAL.fifo.bytesTotal, ST25R200_FIFO_DEPTH);
-      st25r200WriteFifo(gRFAL.TxRx.ctx.txBuf, gRFAL.fifo.bytesWritten);
-
-      /*Check if Observation Mode is enabled and set it on ST25R391x */
-      rfalCheckEnableObsModeTx();
+      /* Clear FIFO, Clear and Enable the Interrupts, load the FIFO unless done during FDT Poll */
+      if (!gRFAL.TxRx.preloaded) {
+        rfalTransceiveTxLoad(false);
+      }
 
       gRFAL.TxRx.state = RFAL_TXRX_STATE_TX_TRANSMIT;
     /* fall through */
@@ -1198,6 +1996,11 @@ void RfalRfST25R200Class::rfalTransceiveTx(void)
     /*******************************************************************************/
     case RFAL_TXRX_STATE_TX_TRANSMIT:   /*  PRQA S 2003 # MISRA 16.3 - Intentional fall through */
 
+      /* Wait until the FIFO has been loaded */
+      if (rfalTransceiveFifoBusy(RFAL_TXRX_STATE_TX_FAIL)) {
+        break;
+      }
+
       /*******************************************************************************/
       /* Execute Sync Transceive Callback                                             */
       /*******************************************************************************/
@@ -1212,6 +2015,12 @@ void RfalRfST25R200Class::rfalTransceiveTx(void)
       /* Trigger/Start transmission                                                  */
       st25r200ExecuteCommand(ST25R200_CMD_TRANSMIT);
 
+      /* FDT Poll of a preloaded frame is set up once transmitting, it only starts at RX end */
+      if (gRFAL.TxRx.preloaded) {
+        rfalPrepareFDTPoll();
+        gRFAL.TxRx.preloaded = false;
+      }
+
       /* Check if a WL level is expected or TXE should come */
       gRFAL.TxRx.state = ((gRFAL.fifo.bytesWritten < gRFAL.fifo.bytesTotal) ? RFAL_TXRX_STATE_TX_WAIT_WL : RFAL_TXRX_STATE_TX_WAIT_TXE);
       break;
@@ -1219,6 +2028,11 @@ void RfalRfST25R200Class::rfalTransceiveTx(void)
     /*******************************************************************************/
     case RFAL_TXRX_STATE_TX_WAIT_WL:
 
+      /* Complete any ongoing FIFO reload */
+      if (rfalTransceiveFifoBusy(RFAL_TXRX_STATE_TX_FAIL)) {
+        break;
+      }
+
       irqs = st25r200GetInterrupt((ST25R200_IRQ_MASK_WL | ST25R200_IRQ_MASK_TXE));
       if (irqs == ST25R200_IRQ_MASK_NONE) {
         break;  /* No interrupt to process */
@@ -1239,7 +2053,7 @@ void RfalRfST25R200Class::rfalTransceiveTx(void)
 
       /* Load FIFO with the remaining length or maximum available */
       tmp = MIN((gRFAL.fifo.bytesTotal - gRFAL.fifo.bytesWritten), gRFAL.fifo.expWL);        /* tmp holds the number of bytes written on this iteration */
-      st25r200WriteFifo(&gRFAL.TxRx.ctx.txBuf[gRFAL.fifo.bytesWritten], tmp);
+      rfalTransceiveTxWrite(gRFAL.fifo.bytesWritten, tmp);
 
       /* Update total written bytes to FIFO */
       gRFAL.fifo.bytesWritten += tmp;
@@ -1252,6 +2066,11 @@ void RfalRfST25R200Class::rfalTransceiveTx(void)
     /*******************************************************************************/
     case RFAL_TXRX_STATE_TX_WAIT_TXE:
 
+      /* Complete any ongoing FIFO reload */
+      if (rfalTransceiveFifoBusy(RFAL_TXRX_STATE_TX_FAIL)) {
+        break;
+      }
+
       irqs = st25r200GetInterrupt((ST25R200_IRQ_MASK_WL | ST25R200_IRQ_MASK_TXE));
       if (irqs == ST25R200_IRQ_MASK_NONE) {
         break;  /* No interrupt to process */
@@ -1340,9 +2159,14 @@ void RfalRfST25R200Class::rfalTransceiveRx(void)
       /* Clear rx counters */
       gRFAL.fifo.bytesWritten   = 0;            /* Total bytes written on RxBuffer         */
       gRFAL.fifo.bytesTotal     = 0;            /* Total bytes in FIFO will now be from Rx */
+      gRFAL.fifo.bytesHarvested = 0;            /* No bytes retrieved at RXE yet           */
       if (gRFAL.TxRx.ctx.rxRcvdLen != NULL) {
         *gRFAL.TxRx.ctx.rxRcvdLen = 0;
       }
+#if ST25R200_FEATURE_RX_STREAM
+      gRFAL.TxRx.stream.written   = 0;
+      gRFAL.TxRx.stream.delivered = 0;
+#endif /* ST25R200_FEATURE_RX_STREAM */
 
       gRFAL.TxRx.state = RFAL_TXRX_STATE_RX_WAIT_RXS;
 
@@ -1380,6 +2204,11 @@ void RfalRfST25R200Class::rfalTransceiveRx(void)
     /*******************************************************************************/
     case RFAL_TXRX_STATE_RX_WAIT_RXE:   /*  PRQA S 2003 # MISRA 16.3 - Intentional fall through */
 
+      /* Complete any ongoing FIFO read out */
+      if (rfalTransceiveFifoBusy(RFAL_TXRX_STATE_RX_FAIL)) {
+        break;
+      }
+
       irqs |= st25r200GetInterrupt((ST25R200_IRQ_MASK_RXE  | ST25R200_IRQ_MASK_WL | ST25R200_IRQ_MASK_RX_REST));
       if (irqs == ST25R200_IRQ_MASK_NONE) {
         break;  /* No interrupt to process */
@@ -1422,6 +2251,20 @@ void RfalRfST25R200Class::rfalTransceiveRx(void)
       /* After RXE retrieve and check for any error irqs */
       irqs |= st25r200GetInterrupt((ST25R200_IRQ_MASK_CRC | ST25R200_IRQ_MASK_PAR | ST25R200_IRQ_MASK_HFE | ST25R200_IRQ_MASK_SFE | ST25R200_IRQ_MASK_COL));
 
+      /* Retrieve the FIFO status together with the received bytes that still fit in rxBuf */
+      if ((irqs & ST25R200_IRQ_MASK_RXE) != 0U) {
+        tmp = gRFAL.fifo.bytesWritten;
+        aux = (uint16_t)(rfalConvBitsToBytes(gRFAL.TxRx.ctx.rxBufLen) - gRFAL.fifo.bytesWritten);
+#if ST25R200_FEATURE_RX_STREAM
+        /* Streaming receive: into the contiguous free space of the ring buffer */
+        if (gRFAL.TxRx.stream.cb != NULL) {
+          tmp = (uint16_t)(gRFAL.TxRx.stream.written % gRFAL.TxRx.stream.size);
+          aux = MIN((uint16_t)(gRFAL.TxRx.stream.size - tmp), (uint16_t)(gRFAL.TxRx.stream.size - (gRFAL.TxRx.stream.written - gRFAL.TxRx.stream.delivered)));
+        }
+#endif /* ST25R200_FEATURE_RX_STREAM */
+        st25r200ReadFifoFrame(gRFAL.fifo.status, &gRFAL.TxRx.ctx.rxBuf[tmp], aux, &gRFAL.fifo.bytesHarvested);
+      }
+
       gRFAL.TxRx.state = RFAL_TXRX_STATE_RX_ERR_CHECK;
     /* fall through */
 
@@ -1494,6 +2337,32 @@ void RfalRfST25R200Class::rfalTransceiveRx(void)
 
       tmp = rfalFIFOStatusGetNumBytes();
 
+#if ST25R200_FEATURE_RX_STREAM
+      /*******************************************************************************/
+      /* Streaming receive: hand the remaining bytes to the consumer, CRC excluded   */
+      if (gRFAL.TxRx.stream.cb != NULL) {
+        gRFAL.TxRx.stream.written += gRFAL.fifo.bytesHarvested;
+        rfalRxStreamRead((tmp - gRFAL.fifo.bytesHarvested), rfalRxStreamHold());
+        gRFAL.fifo.bytesHarvested = 0;
+
+        aux = gRFAL.TxRx.stream.written;
+        if ((rfalRxStreamHold() != 0U) && (aux > RFAL_CRC_LEN)) {
+          aux -= RFAL_CRC_LEN;
+        }
+        rfalRxStreamDeliver(aux);
+
+        if (gRFAL.TxRx.ctx.rxRcvdLen != NULL) {
+          (*gRFAL.TxRx.ctx.rxRcvdLen) = (uint16_t)rfalConvBytesToBits(aux);
+          if (rfalFIFOStatusIsIncompleteByte()) {
+            (*gRFAL.TxRx.ctx.rxRcvdLen) -= (RFAL_BITS_IN_BYTE - rfalFIFOGetNumIncompleteBits());
+          }
+        }
+
+        gRFAL.TxRx.state = ((gRFAL.TxRx.status != ERR_BUSY) ? RFAL_TXRX_STATE_RX_FAIL : RFAL_TXRX_STATE_RX_DONE);
+        break;
+      }
+#endif /* ST25R200_FEATURE_RX_STREAM */
+
       /*******************************************************************************/
       /* Check if CRC should not be placed in rxBuf                                  */
       if (((gRFAL.TxRx.ctx.flags & (uint32_t)RFAL_TXRX_FLAGS_CRC_RX_KEEP) == 0U)) {
@@ -1527,8 +2396,12 @@ void RfalRfST25R200Class::rfalTransceiveRx(void)
       }
 
       /*******************************************************************************/
-      /* Retrieve remaining bytes from FIFO to rxBuf, and assign total length rcvd   */
-      st25r200ReadFifo(&gRFAL.TxRx.ctx.rxBuf[gRFAL.fifo.bytesWritten], tmp);
+      /* Retrieve remaining bytes from FIFO to rxBuf, and assign total length rcvd   *
+       * Bytes already retrieved together with the FIFO status are not read again    */
+      if (tmp > gRFAL.fifo.bytesHarvested) {
+        st25r200ReadFifoStart(&gRFAL.TxRx.ctx.rxBuf[gRFAL.fifo.bytesWritten + gRFAL.fifo.bytesHarvested], (tmp - gRFAL.fifo.bytesHarvested));
+      }
+      gRFAL.fifo.bytesHarvested = 0;
       if (gRFAL.TxRx.ctx.rxRcvdLen != NULL) {
         (*gRFAL.TxRx.ctx.rxRcvdLen) = (uint16_t)rfalConvBytesToBits(gRFAL.fifo.bytesTotal);
         if (rfalFIFOStatusIsIncompleteByte()) {
@@ -1550,6 +2423,11 @@ void RfalRfST25R200Class::rfalTransceiveRx(void)
     /*******************************************************************************/
     case RFAL_TXRX_STATE_RX_DONE:   /*  PRQA S 2003 # MISRA 16.3 - Intentional fall through */
 
+      /* Wait until the remaining bytes have been retrieved */
+      if (rfalTransceiveFifoBusy(RFAL_TXRX_STATE_RX_FAIL)) {
+        break;
+      }
+
       /*Check if Observation Mode was enabled and disable it on ST25R391x */
       rfalCheckDisableObsMode();
 
@@ -1567,13 +2445,25 @@ void RfalRfST25R200Class::rfalTransceiveRx(void)
       tmp = rfalFIFOStatusGetNumBytes();
       gRFAL.fifo.bytesTotal += tmp;
 
+#if ST25R200_FEATURE_RX_STREAM
+      /*******************************************************************************/
+      /* Streaming receive: hand the incoming bytes to the consumer right away       */
+      if (gRFAL.TxRx.stream.cb != NULL) {
+        rfalRxStreamRead(tmp, rfalRxStreamHold());
+
+        rfalFIFOStatusClear();
+        gRFAL.TxRx.state  = RFAL_TXRX_STATE_RX_WAIT_RXE;
+        break;
+      }
+#endif /* ST25R200_FEATURE_RX_STREAM */
+
       /*******************************************************************************/
       /* Calculate the amount of bytes that still fits in rxBuf                      */
       aux = ((gRFAL.fifo.bytesTotal > rfalConvBitsToBytes(gRFAL.TxRx.ctx.rxBufLen)) ? (rfalConvBitsToBytes(gRFAL.TxRx.ctx.rxBufLen) - gRFAL.fifo.bytesWritten) : tmp);
 
       /*******************************************************************************/
       /* Retrieve incoming bytes from FIFO to rxBuf, and store already read amount   */
-      st25r200ReadFifo(&gRFAL.TxRx.ctx.rxBuf[gRFAL.fifo.bytesWritten], aux);
+      st25r200ReadFifoStart(&gRFAL.TxRx.ctx.rxBuf[gRFAL.fifo.bytesWritten], aux);
       gRFAL.fifo.bytesWritten += aux;
 
       /*******************************************************************************/
@@ -1591,9 +2481,22 @@ void RfalRfST25R200Class::rfalTransceiveRx(void)
     /*******************************************************************************/
     case RFAL_TXRX_STATE_RX_FAIL:
 
+      /* Wait until the remaining bytes have been retrieved */
+      if (st25r200FifoXferIsBusy()) {
+        break;
+      }
+
+      /* Already failed, an aborted read out does not change the error reported */
+      st25r200FifoXferWait();
+
       /*Check if Observation Mode was enabled and disable it on ST25R391x */
       rfalCheckDisableObsMode();
 
+      /* Restart from the transmission if the retry policy allows */
+      if (rfalTransceiveRetry()) {
+        break;
+      }
+
       /* Clean up Transceive */
       rfalCleanupTransceive();
 
@@ -1965,7 +2868,7 @@ ReturnCode RfalRfST25R200Class::rfalISO15693TransceiveEOF(uint8_t *rxBuf, uint16
   st25r200ExecuteCommand(ST25R200_CMD_TRANSMIT_EOF);
 
   /* Wait for TXE */
-  if (st25r200WaitForInterruptsTimed(ST25R200_IRQ_MASK_TXE, (uint16_t)MAX(rfalConv1fcToMs(RFAL_ISO15693_FWT), RFAL_ST25R200_SW_TMR_MIN_1MS)) == 0U) {
+  if (st25r200WaitForInterruptsTimedUs(ST25R200_IRQ_MASK_TXE, MAX(rfalST25R200Conv1fcToUs(RFAL_ISO15693_FWT), RFAL_ST25R200_SW_TMR_MIN_1US)) == 0U) {
     ret = ERR_IO;
   } else {
     /*Check if Observation Mode is enabled and set it on ST25R391x */
@@ -2201,6 +3104,9 @@ ReturnCode RfalRfST25R200Class::rfalWakeUpModeStart(const rfalWakeUpConfig *conf
   measI = 0U;
   measQ = 0U;
 
+  /* Keep the bus for the whole Wake-Up configuration */
+  ST25R200BusSession session(this);
+
   /* Disable Tx, Rx */
   st25r200TxRxOff();
 
@@ -2208,6 +3114,9 @@ ReturnCode RfalRfST25R200Class::rfalWakeUpModeStart(const rfalWakeUpConfig *conf
   rfalSetAnalogConfig((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_WAKEUP_ON));
 
 
+  /* Both Wake-Up configuration registers are written with a single burst */
+  st25r200BatchBegin();
+
   /*******************************************************************************/
   /* Prepare Wake-Up Timer Control Register */
   aux = (uint8_t)(((uint8_t)gRFAL.wum.cfg.period & 0x0FU) << ST25R200_REG_WAKEUP_CONF1_wut_shift);
@@ -2232,6 +3141,7 @@ ReturnCode RfalRfST25R200Class::rfalWakeUpModeStart(const rfalWakeUpConfig *conf
 
   st25r200WriteRegister(ST25R200_REG_WAKEUP_CONF2, aux);
 
+  st25r200BatchCommit();
 
   /* Check if a manual reference is to be obtained */
   if ((!gRFAL.wum.cfg.autoAvg)                                                                  &&
@@ -2249,6 +3159,9 @@ ReturnCode RfalRfST25R200Class::rfalWakeUpModeStart(const rfalWakeUpConfig *conf
   }
 
 
+  /* Queue the I and Q channel configuration */
+  st25r200BatchBegin();
+
   /*******************************************************************************/
   /* Check if I-Channel is to be checked */
   if (gRFAL.wum.cfg.indAmp.enabled) {
@@ -2291,6 +3204,8 @@ ReturnCode RfalRfST25R200Class::rfalWakeUpModeStart(const rfalWakeUpConfig *conf
     st25r200ClrRegisterBits(ST25R200_REG_WU_Q_CONF, ST25R200_REG_WU_Q_CONF_q_tdi_en_mask);
   }
 
+  st25r200BatchCommit();
+
   /* Disable and clear all interrupts except Wake-Up IRQs */
   st25r200DisableInterrupts(ST25R200_IRQ_MASK_ALL);
   st25r200GetInterrupt(irqs);
@@ -46,9 +46,10 @@
 #include "st25r200.h"
 #include "st25r200_com.h"
 #include "st25r200_interrupt.h"
+#include "st25r200_transport.h"
+#include "st25r200_transport_arduino.h"
 #include "rfal_rfst25r200_analogConfig.h"
 #include "rfal_rfst25r200_iso15693_2.h"
-#include <functional>
 
 /*
  ******************************************************************************
@@ -68,6 +69,54 @@
   #define RFAL_FEATURE_LOWPOWER_MODE  false   /* Low Power mode configuration missing. Disabled by default */
 #endif /* RFAL_FEATURE_LOWPOWER_MODE */
 
+#ifndef ST25R200_FEATURE_SHADOW_REGS
+  #define ST25R200_FEATURE_SHADOW_REGS  false   /* Shadow copy of configuration registers for read-modify-write. Disabled by default */
+#endif /* ST25R200_FEATURE_SHADOW_REGS */
+
+#ifndef ST25R200_FEATURE_REG_BATCH
+  #define ST25R200_FEATURE_REG_BATCH    true    /* Coalescing of queued register writes into bursts. Enabled by default */
+#endif /* ST25R200_FEATURE_REG_BATCH */
+
+#ifndef ST25R200_FEATURE_FIFO_ASYNC
+  #define ST25R200_FEATURE_FIFO_ASYNC   true    /* Non-blocking FIFO transfers through a user transfer hook. Enabled by default */
+#endif /* ST25R200_FEATURE_FIFO_ASYNC */
+
+#ifndef ST25R200_FEATURE_BUS_SESSION
+  #define ST25R200_FEATURE_BUS_SESSION  true    /* Bus kept locked across consecutive accesses of a session. Enabled by default */
+#endif /* ST25R200_FEATURE_BUS_SESSION */
+
+#ifndef ST25R200_FEATURE_DEFERRED_IRQ
+  #define ST25R200_FEATURE_DEFERRED_IRQ false   /* IRQ handler only queues an event, chip readout done by rfalWorker(). Disabled by default */
+#endif /* ST25R200_FEATURE_DEFERRED_IRQ */
+
+#ifndef ST25R200_FEATURE_TX_PRELOAD
+  #define ST25R200_FEATURE_TX_PRELOAD   false   /* Frame preparation and FIFO load overlapped with the FDT Poll wait. Disabled by default */
+#endif /* ST25R200_FEATURE_TX_PRELOAD */
+
+#ifndef ST25R200_FEATURE_RX_STREAM
+  #define ST25R200_FEATURE_RX_STREAM    true    /* Streaming receive of frames through a ring buffer and a consumer callback. Enabled by default */
+#endif /* ST25R200_FEATURE_RX_STREAM */
+
+#ifndef ST25R200_FEATURE_PROFILER
+  #define ST25R200_FEATURE_PROFILER     false   /* Timing statistics per transceive state, per mode and of IRQ retrieval. Disabled by default */
+#endif /* ST25R200_FEATURE_PROFILER */
+
+#ifndef ST25R200_FEATURE_ADAPTIVE_FWT
+  #define ST25R200_FEATURE_ADAPTIVE_FWT false   /* FWT shrunk to the response times learned per mode and command class. Disabled by default */
+#endif /* ST25R200_FEATURE_ADAPTIVE_FWT */
+
+#ifndef ST25R200_FEATURE_ANALOG_INDEX
+  #define ST25R200_FEATURE_ANALOG_INDEX true    /* Analog Configuration IDs looked up through an index built at initialization. Enabled by default */
+#endif /* ST25R200_FEATURE_ANALOG_INDEX */
+
+#ifndef ST25R200_FEATURE_ANALOG_DELTA
+  #define ST25R200_FEATURE_ANALOG_DELTA true    /* Analog Configuration changes skipped when the register bits already hold them. Enabled by default */
+#endif /* ST25R200_FEATURE_ANALOG_DELTA */
+
+#ifndef ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG
+  #define ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG false /* Analog Configuration tables loaded at runtime into RAM (2 x RFAL_ANALOG_CONFIG_TBL_SIZE). Disabled by default */
+#endif /* ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG */
+
 
 /*
 ******************************************************************************
@@ -75,6 +124,72 @@
 ******************************************************************************
 */
 
+/*! Completion callback of an asynchronous transceive
+ *
+ *  \param[in] cbCtx  : user context given on rfalStartTransceiveAsync()
+ *  \param[in] status : transceive status, as returned by rfalGetTransceiveStatus()
+ *  \param[in] rxLen  : received length in bits, as returned in rxRcvdLen
+ */
+typedef void (*rfalTransceiveDoneCallback)(void *cbCtx, ReturnCode status, uint16_t rxLen);
+
+
+/*! Consumer callback of a streaming receive
+ *
+ *  \param[in] cbCtx : user context given on rfalStartTransceiveStream()
+ *  \param[in] data  : received bytes, only valid during the call
+ *  \param[in] len   : number of received bytes
+ */
+typedef void (*rfalRxStreamCallback)(void *cbCtx, const uint8_t *data, uint16_t len);
+
+
+/*! Per mode configuration: protocol registers, analog configuration and timing adjustments     */
+typedef struct {
+  rfalMode                mode;        /*!< Mode described, index check of the table            */
+  bool                    supported;   /*!< Mode supported by the ST25R200                      */
+  uint8_t                 protocol;    /*!< PROTOCOL register value (operation mode)            */
+  uint8_t                 tx2Mask;     /*!< PROTOCOL_TX2 bits to be set, 0 if none              */
+  uint8_t                 tx2Val;      /*!< PROTOCOL_TX2 value of the bits set                  */
+  uint8_t                 rx1Mask;     /*!< PROTOCOL_RX1 bits to be set, 0 if none              */
+  uint8_t                 rx1Val;      /*!< PROTOCOL_RX1 value of the bits set                  */
+  uint8_t                 rx2Mask;     /*!< PROTOCOL_RX2 bits to be set, 0 if none              */
+  uint8_t                 rx2Val;      /*!< PROTOCOL_RX2 value of the bits set                  */
+  uint16_t                analogTech;  /*!< Analog configuration ID (mode and technology) w/o bit rate and direction */
+  uint16_t                fdtListenAdj;/*!< FDT Listen adjustment in 1/fc on top of the MRT one */
+  uint16_t                fwtAdj;      /*!< FWT adjustment in 1/fc on top of the common one     */
+} rfalModeDesc;
+
+
+/*! Transmit segment of a scatter-gather transceive                                             */
+typedef struct {
+  const uint8_t           *data;       /*!< Segment data                                        */
+  uint16_t                len;         /*!< Segment length in bytes                             */
+} rfalTxSegment;
+
+
+/*! Struct that holds the ring buffer state of a streaming receive                                */
+typedef struct {
+  rfalRxStreamCallback    cb;          /*!< Consumer callback, NULL when not streaming          */
+  void                    *cbCtx;      /*!< User context of the consumer callback               */
+  uint16_t                size;        /*!< Ring buffer size in bytes (rxBuf)                   */
+  uint16_t                written;     /*!< Bytes of the frame read into the ring buffer        */
+  uint16_t                delivered;   /*!< Bytes of the frame handed to the consumer           */
+} rfalRxStream;
+
+
+#define RFAL_TXRX_RETRY_TIMEOUT        0x01U    /*!< Retry on ERR_TIMEOUT                                       */
+#define RFAL_TXRX_RETRY_CRC            0x02U    /*!< Retry on ERR_CRC                                           */
+#define RFAL_TXRX_RETRY_FRAMING        0x04U    /*!< Retry on ERR_FRAMING                                       */
+#define RFAL_TXRX_RETRY_PAR            0x08U    /*!< Retry on ERR_PAR                                           */
+#define RFAL_TXRX_RETRY_COLLISION      0x10U    /*!< Retry on ERR_RF_COLLISION                                  */
+
+/*! Retry policy of the transceives                                                               */
+typedef struct {
+  uint8_t                 maxAttempts; /*!< Attempts including the first one, 0 or 1 for none  */
+  uint8_t                 errors;      /*!< Errors retried, RFAL_TXRX_RETRY_xxx                 */
+  uint32_t                delayUs;     /*!< Delay before a new attempt in us                    */
+} rfalTransceiveRetryPolicy;
+
+
 /*! Struct that holds all involved on a Transceive including the context passed by the caller     */
 typedef struct {
   rfalTransceiveState     state;       /*!< Current transceive state                            */
@@ -83,6 +198,16 @@ typedef struct {
 
   rfalTransceiveContext   ctx;         /*!< The transceive context given by the caller          */
 
+  rfalTransceiveDoneCallback doneCb;   /*!< Completion callback of an asynchronous transceive   */
+  void                    *doneCbCtx;  /*!< User context of the completion callback             */
+  uint16_t                rxLen;       /*!< Received length when the caller provides none       */
+  bool                    preloaded;   /*!< Frame prepared and FIFO loaded during FDT Poll      */
+  rfalRxStream            stream;      /*!< Streaming receive state                             */
+  const rfalTxSegment     *txSeg;      /*!< Transmit segments, NULL when txBuf is contiguous    */
+  uint8_t                 txSegCnt;    /*!< Number of transmit segments                         */
+  rfalTransceiveRetryPolicy retry;     /*!< Retry policy                                        */
+  uint8_t                 attempt;     /*!< Attempts made by the current transceive             */
+
 } rfalTxRx;
 
 
@@ -139,6 +264,7 @@ typedef struct {
   uint16_t                bytesTotal;  /*!< Total bytes to be transmitted OR the total bytes received                                  */
   uint16_t                bytesWritten;/*!< Amount of bytes already written on FIFO (Tx) OR read (RX) from FIFO and written on rxBuffer*/
   uint8_t                 status[ST25R200_FIFO_STATUS_LEN];   /*!< FIFO Status Registers                                              */
+  uint16_t                bytesHarvested;/*!< Amount of bytes of the last frame already read together with the FIFO status at RXE    */
 } rfalFIFO;
 
 
@@ -174,6 +300,7 @@ typedef struct {
   rfalFIFO                fifo;        /*!< RFAL's FIFO management                                    */
   rfalTimers              tmr;         /*!< RFAL's Software timers                                    */
   rfalCallbacks           callbacks;   /*!< RFAL's callbacks                                          */
+  bool                    txrxFlagsRestore; /*!< Default transceive flags to be restored when leaving transceive */
 
 
 #if RFAL_FEATURE_WAKEUP_MODE
@@ -192,30 +319,170 @@ typedef struct {
 
 
 
+/*! Struct that holds the shadow copy of the ST25R200 configuration registers
+ *
+ *  Kept up to date by the communication layer on every register access: a bit
+ *  is known once it has been written to or read from the chip, until the
+ *  chip is set to default or a register write fails.
+ */
+typedef struct {
+  uint8_t                 val[ST25R200_REG_IC_ID + 1U];   /*!< Value of the known bits          */
+  uint8_t                 known[ST25R200_REG_IC_ID + 1U]; /*!< Bits whose value on the chip is known */
+} st25r200ShadowRegs;
+
+
+/*! Struct that holds a queued register change of a register batch                                */
+typedef struct {
+  uint8_t                 reg;         /*!< Register address                                    */
+  uint8_t                 mask;        /*!< Bits to be changed                                  */
+  uint8_t                 val;         /*!< New value of the bits to be changed                 */
+} st25r200RegBatchEntry;
+
+
+/*! Struct that holds the register changes queued between st25r200BatchBegin and st25r200BatchCommit */
+typedef struct {
+  st25r200RegBatchEntry   entry[ST25R200_REG_BATCH_LEN]; /*!< Queued changes, one per register */
+  uint8_t                 cnt;         /*!< Number of queued changes                            */
+  uint8_t                 depth;       /*!< Nesting level of the open batches                   */
+} st25r200RegBatch;
+
+
+/*! Asynchronous FIFO transfer hook
+ *  Starts the data phase of a FIFO access and returns immediately. The FIFO command byte has
+ *  already been sent and the chip is selected, the hook must not release the chip select.
+ *  Once the transfer has completed st25r200FifoXferDone() shall be called (e.g. from a DMA ISR).
+ *  txData is NULL on FIFO reads, rxData is NULL on FIFO writes and on reads to be discarded.
+ *  A return value other than ERR_NONE makes the driver perform the transfer itself          */
+typedef ReturnCode(*st25r200FifoXferHook)(void *ctx, const uint8_t *txData, uint8_t *rxData, uint16_t length);
+
+
+/*! Struct that holds the state of the asynchronous FIFO transfer                                 */
+typedef struct {
+  st25r200FifoXferHook    hook;        /*!< Transfer hook, NULL if not available                */
+  void                   *ctx;         /*!< Context passed to the transfer hook                 */
+  volatile bool           done;        /*!< Set by st25r200FifoXferDone() on completion         */
+  volatile bool           busy;        /*!< Transfer ongoing, the bus is owned by the hook      */
+  uint32_t                tmr;         /*!< Timer bounding the transfer                         */
+  ReturnCode              status;      /*!< Result of the last transfer, reported once          */
+} st25r200FifoXfer;
+
+
+#define RFAL_ANALOG_CONFIG_IDX_TECHS   8U       /*!< Technology slots of the index: chip specific plus one per technology bit */
+#define RFAL_ANALOG_CONFIG_IDX_BUCKETS (2U * 16U * RFAL_ANALOG_CONFIG_IDX_TECHS) /*!< Index buckets: Poll/Listen x Bit rate x Technology slot */
+#define RFAL_ANALOG_CONFIG_IDX_LEN     (2U * RFAL_ANALOG_CONFIG_LUT_SIZE) /*!< Max entries of the index, an ID is listed once per technology bit set */
+
+/*! Index of the Analog Configuration LUT
+ *
+ *  Configuration IDs are bucketed on the fields every search matches exactly
+ *  (Poll/Listen, Bit rate) and on the technology, an ID shared by several
+ *  technologies being listed in each of their buckets. A bucket holds the
+ *  offsets of its IDs in table order.
+ */
+typedef struct {
+  uint8_t  start[RFAL_ANALOG_CONFIG_IDX_BUCKETS + 1U]; /*!< Position of the first offset of each bucket */
+  uint16_t offset[RFAL_ANALOG_CONFIG_IDX_LEN];          /*!< Offsets of the Configuration IDs in the table */
+  bool     valid;                  /*!< Index built, otherwise the table is searched linearly    */
+} rfalAnalogConfigIndex;
+
+
 /*! Struct for Analog Config Look Up Table Update */
 typedef struct {
   const uint8_t *currentAnalogConfigTbl; /*!< Reference to start of current Analog Configuration */
   uint16_t configTblSize;          /*!< Total size of Analog Configuration                       */
   bool     ready;                  /*!< Indicate if Look Up Table is complete and ready for use  */
+#if ST25R200_FEATURE_ANALOG_INDEX
+  rfalAnalogConfigIndex idx;       /*!< Index of the Configuration IDs                           */
+#endif /* ST25R200_FEATURE_ANALOG_INDEX */
+#if ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG
+  uint16_t shadowTblSize;          /*!< Size of the table prepared in the RAM buffer not in use  */
+  bool     shadowOpen;             /*!< rfalAnalogConfigListWrite() list being written           */
+  bool     swapPending;            /*!< Prepared table to be put in use once no transceive runs  */
+#endif /* ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG */
 } rfalAnalogConfigMgmt;
 
-template <typename T>
-struct Callback;
-
-template <typename Ret, typename... Params>
-struct Callback<Ret(Params...)> {
-  template <typename... Args>
-  static Ret callback(Args... args)
-  {
-    return func(args...);
-  }
-  static std::function<Ret(Params...)> func;
-};
+typedef void (*ST25R200IrqHandler)(void);
 
-template <typename Ret, typename... Params>
-std::function<Ret(Params...)> Callback<Ret(Params...)>::func;
+/*! Time source of the software timers: free running microsecond counter wrapping at 2^32 */
+typedef uint32_t (*st25r200TimeSource)(void);
 
-typedef void (*ST25R200IrqHandler)(void);
+#define ST25R200_IRQ_DISPATCH_SLOTS    4U       /*!< Max number of instances with their interrupt line attached */
+
+#define RFAL_TXRX_QUEUE_LEN            8U       /*!< Max number of transceives queued                           */
+
+/*! Queued transceive: the context to be executed and its result slot */
+typedef struct {
+  rfalTransceiveContext   ctx;         /*!< Transceive context                                  */
+  ReturnCode              status;      /*!< Result of the transceive, ERR_BUSY until completed  */
+  uint16_t                rxLen;       /*!< Received length in bits                             */
+} rfalTransceiveQueueEntry;
+
+
+/*! Queue of transceives executed back-to-back by rfalWorker()                                    */
+typedef struct {
+  rfalTransceiveQueueEntry *entry[RFAL_TXRX_QUEUE_LEN]; /*!< Queued entries, head one running  */
+  uint8_t                 head;        /*!< Index of the entry running or next to run           */
+  uint8_t                 count;       /*!< Number of entries queued, running one included      */
+  bool                    running;     /*!< Head entry has been started                         */
+} rfalTxRxQueue;
+
+
+#define RFAL_PROF_HIST_BINS            12U      /*!< Histogram bins, bin n counts durations in [2^(n-1), 2^n) us, last one above */
+#define RFAL_PROF_TX_STATES            16U      /*!< Tx transceive states tracked, from RFAL_TXRX_STATE_TX_IDLE */
+#define RFAL_PROF_RX_STATES            16U      /*!< Rx transceive states tracked, from RFAL_TXRX_STATE_RX_IDLE */
+#define RFAL_PROF_STATES               (RFAL_PROF_TX_STATES + RFAL_PROF_RX_STATES) /*!< Transceive states tracked */
+#define RFAL_PROF_MODES                16U      /*!< RFAL modes tracked                                         */
+
+/*! Average of a profiler statistic in us */
+#define rfalProfStatAvg(s)             (((s)->count != 0U) ? ((s)->sum / (s)->count) : 0U)
+
+/*! Duration statistic of the profiler, durations in us                                          */
+typedef struct {
+  uint32_t                count;       /*!< Number of samples                                   */
+  uint32_t                min;         /*!< Shortest duration                                   */
+  uint32_t                max;         /*!< Longest duration                                    */
+  uint32_t                sum;         /*!< Sum of the durations                                */
+  uint16_t                hist[RFAL_PROF_HIST_BINS]; /*!< Log2 histogram, saturating counters  */
+} rfalProfStat;
+
+
+/*! Transceive profiler                                                                           */
+typedef struct {
+  rfalProfStat            state[RFAL_PROF_STATES]; /*!< Time spent in each transceive state     */
+  rfalProfStat            mode[RFAL_PROF_MODES];   /*!< Whole transceive duration per mode      */
+  rfalProfStat            irq;         /*!< Latency from IRQ latch to retrieval                 */
+  rfalTransceiveState     curState;    /*!< Transceive state being timed                        */
+  uint32_t                stateTs;     /*!< Time the current state was entered                  */
+  uint32_t                txrxTs;      /*!< Time the current transceive was started             */
+  volatile uint32_t       irqTs;       /*!< Time the pending interrupts were latched            */
+} rfalProfiler;
+
+
+#define RFAL_AFWT_MODES                16U      /*!< RFAL modes with learned FWT                                */
+#define RFAL_AFWT_CLASSES              4U       /*!< Command classes with learned FWT per mode                  */
+#define RFAL_AFWT_MIN_SAMPLES          4U       /*!< Responses observed before the FWT is shrunk                */
+#define RFAL_AFWT_DECAY_SHIFT          5U       /*!< Learned response time decays by 1/2^n on every response    */
+#define RFAL_AFWT_MARGIN_1FC           rfalST25R200Conv1usTo1fc(300U) /*!< Margin added to the learned FWT   */
+
+/*! Learned response time of a mode and command class                                             */
+typedef struct {
+  uint32_t                resp;        /*!< Decaying maximum of the response times in 1/fc      */
+  uint8_t                 samples;     /*!< Responses since the last timeout, saturating        */
+} rfalAdaptiveFwtEntry;
+
+
+/*! Adaptive FWT engine                                                                           */
+typedef struct {
+  rfalAdaptiveFwtEntry    entry[RFAL_AFWT_MODES][RFAL_AFWT_CLASSES]; /*!< Learned response times */
+  bool                    enabled;     /*!< Adaptive FWT enabled                                */
+  uint8_t                 cls;         /*!< Command class of the next transceives               */
+  rfalAdaptiveFwtEntry    *cur;        /*!< Entry of the running transceive, NULL if none       */
+  bool                    shrunk;      /*!< Running transceive uses a learned FWT               */
+  volatile uint32_t       irqTs;       /*!< Time the IRQ line was asserted                      */
+  volatile bool           irqTsValid;  /*!< irqTs holds the time of the unserved interrupts     */
+  volatile uint32_t       txeTs;       /*!< Time TXE was latched                                */
+  volatile uint32_t       rxsTs;       /*!< Time RXS was latched                                */
+  volatile uint32_t       seen;        /*!< TXE/RXS latched during the running transceive       */
+} rfalAdaptiveFwt;
 
 /*
 ******************************************************************************
@@ -236,13 +503,15 @@ typedef void (*ST25R200IrqHandler)(void);
 #define RFAL_ST25R200_MRT_MAX_1FC      rfalConv64fcTo1fc( 0x00FFU )                   /*!< Max MRT steps in 1fc (0x00FF steps of 64/fc   => 0x00FF * 4.72us = 1.2ms )      */
 #define RFAL_ST25R200_MRT_MIN_1FC      rfalConv64fcTo1fc( 0x0004U )                   /*!< Min MRT steps in 1fc ( 0<=mrt<=4 ; 4 (64/fc)  => 0x0004 * 4.72us = 18.88us )    */
 #define RFAL_ST25R200_GT_MAX_1FC       rfalConvMsTo1fc( 6000U )                       /*!< Max GT value allowed in 1/fc (SFGI=14 => SFGT + dSFGT = 5.4s)                   */
-#define RFAL_ST25R200_GT_MIN_1FC       rfalConvMsTo1fc(RFAL_ST25R200_SW_TMR_MIN_1MS)  /*!< Min GT value allowed in 1/fc                                                    */
+#define RFAL_ST25R200_GT_MIN_1FC       rfalST25R200Conv1usTo1fc(RFAL_ST25R200_SW_TMR_MIN_1US) /*!< Min GT value allowed in 1/fc                                            */
 #define RFAL_ST25R200_SW_TMR_MIN_1MS   1U                                             /*!< Min value of a SW timer in ms                                                   */
+#define RFAL_ST25R200_SW_TMR_MIN_1US   1U                                             /*!< Min value of a SW timer in us                                                   */
 
 #define RFAL_OBSMODE_DISABLE            0x0000U                                       /*!< Observation Mode disabled                                                       */
 
 #define RFAL_RX_INC_BYTE_LEN            (uint8_t)1U                                   /*!< Threshold where incoming rx shall be considered incomplete byte NFC - T2T       */
 #define RFAL_EMVCO_RX_MAXLEN            (uint8_t)4U                                   /*!< Maximum value where EMVCo to apply special error handling                       */
+#define RFAL_RX_STREAM_MIN_LEN          16U                                           /*!< Min ring buffer size in bytes of a streaming receive                            */
 
 #define RFAL_NORXE_TOUT                 50U                                           /*!< Timeout to be used on a potential missing RXE                                   */
 
@@ -345,8 +614,12 @@ typedef void (*ST25R200IrqHandler)(void);
 #define rfalCalcNumBytes( nBits )                (((uint32_t)(nBits) + 7U) / 8U)                                 /*!< Returns the number of bytes required to fit given the number of bits */
 
 #define rfalTimerStart( timer, time_ms )         (timer) = timerCalculateTimer((uint16_t)(time_ms))                /*!< Configures and starts the RTOX timer                                 */
+#define rfalTimerStartUs( timer, time_us )       (timer) = timerCalculateTimerUs((uint32_t)(time_us))              /*!< Configures and starts a timer given in us                            */
 #define rfalTimerisExpired( timer )              timerIsExpired( timer )                                 /*!< Checks if timer has expired                                          */
 
+#define rfalST25R200Conv1fcToUs( t )            (((((uint32_t)(t)) / 339U) * 25U) + (((((uint32_t)(t)) % 339U) * 25U + 338U) / 339U)) /*!< Converts 1/fc to us, rounded up (fc = 13.56MHz = 339/25 MHz) */
+#define rfalST25R200Conv1usTo1fc( t )           (((((uint32_t)(t)) * 339U) + 24U) / 25U)                         /*!< Converts us to 1/fc, rounded up                                      */
+
 #define rfalST25R200ObsModeDisable()            st25r200WriteTestRegister(0x02U, 0x00U)                          /*!< Disable ST25R200 Observation mode                                    */
 #define rfalST25R200ObsModeTx(arr)                 st25r200WriteMultipleTestRegister(0x02U, arr, 2U)  /*!< Enable Tx Observation mode                                           */
 #define rfalST25R200ObsModeRx(arr)                 st25r200WriteMultipleTestRegister(0x02U, arr, 2U)  /*!< Enable Rx Observation mode                                           */
@@ -381,6 +654,8 @@ class RfalRfST25R200Class : public RfalRfClass {
     */
 
     RfalRfST25R200Class(SPIClass *spi, int cs_pin, int int_pin, int reset_pin = -1, uint32_t spi_speed = 5000000);
+    RfalRfST25R200Class(ST25R200Transport *transport, int int_pin, int reset_pin = -1);
+    ~RfalRfST25R200Class();
     ReturnCode rfalInitialize(void);
     ReturnCode rfalCalibrate(void);
     ReturnCode rfalAdjustRegulators(uint16_t *result);
@@ -408,6 +683,239 @@ class RfalRfST25R200Class : public RfalRfClass {
     ReturnCode rfalFieldOnAndStartGT(void);
     ReturnCode rfalFieldOff(void);
     ReturnCode rfalStartTransceive(const rfalTransceiveContext *ctx);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Start an asynchronous transceive
+    *
+    *  Starts the transceive described by \a ctx like rfalStartTransceive().
+    *  Instead of polling its status, \a cb is called from rfalWorker() once
+    *  the transceive has completed. rfalWorker() is to be called whenever the
+    *  callback set with rfalSetUpperLayerCallback() signals an interrupt.
+    *
+    *  \param[in] ctx   : transceive context
+    *  \param[in] cb    : completion callback
+    *  \param[in] cbCtx : user context passed to \a cb
+    *
+    *  \return ERR_PARAM       : Invalid parameter
+    *  \return ERR_WRONG_STATE : RFAL not initialized, mode not set or field off
+    *  \return ERR_NONE        : Transceive started
+    *****************************************************************************
+    */
+    ReturnCode rfalStartTransceiveAsync(const rfalTransceiveContext *ctx, rfalTransceiveDoneCallback cb, void *cbCtx);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Start a scatter-gather transceive
+    *
+    *  Starts the transceive described by \a ctx like rfalStartTransceive(),
+    *  except that the frame is transmitted from the \a segCnt segments of
+    *  \a seg, in order, instead of txBuf. The FIFO is filled directly from the
+    *  segments, so header, UID and payload need not be concatenated first.
+    *  The segments must remain valid until the transmission is done.
+    *
+    *  \param[in] ctx    : transceive context, txBuf is ignored and txBufLen is
+    *                      the frame length in bits, 0 to transmit all segments
+    *  \param[in] seg    : transmit segments
+    *  \param[in] segCnt : number of transmit segments
+    *
+    *  \return ERR_PARAM       : Invalid parameter
+    *  \return ERR_WRONG_STATE : RFAL not initialized, mode not set or field off
+    *  \return ERR_NONE        : Transceive started
+    *****************************************************************************
+    */
+    ReturnCode rfalStartTransceiveSg(const rfalTransceiveContext *ctx, const rfalTxSegment *seg, uint8_t segCnt);
+
+#if ST25R200_FEATURE_RX_STREAM
+    /*!
+    *****************************************************************************
+    *  \brief  Start a transceive with streaming receive
+    *
+    *  Starts the transceive described by \a ctx like rfalStartTransceive(),
+    *  except that the rxBuf of \a ctx is used as a ring buffer: the received
+    *  bytes are handed to \a cb as soon as each FIFO water level is serviced,
+    *  while the frame is still being received. Frames larger than rxBuf can
+    *  thus be received, rxRcvdLen holds the total length of the frame.
+    *  Unless RFAL_TXRX_FLAGS_CRC_RX_KEEP is set the CRC bytes are not handed
+    *  to \a cb. \a cb is called from the transceive worker and must consume
+    *  or copy the data before returning.
+    *
+    *  \param[in] ctx   : transceive context, rxBuf of at least RFAL_RX_STREAM_MIN_LEN bytes
+    *  \param[in] cb    : consumer callback
+    *  \param[in] cbCtx : user context passed to \a cb
+    *
+    *  \return ERR_PARAM       : Invalid parameter
+    *  \return ERR_WRONG_STATE : RFAL not initialized, mode not set or field off
+    *  \return ERR_NONE        : Transceive started
+    *****************************************************************************
+    */
+    ReturnCode rfalStartTransceiveStream(const rfalTransceiveContext *ctx, rfalRxStreamCallback cb, void *cbCtx);
+#endif /* ST25R200_FEATURE_RX_STREAM */
+
+    /*!
+    *****************************************************************************
+    *  \brief  Queue a transceive
+    *
+    *  Appends \a entry to the transceive queue. Queued transceives are
+    *  executed back-to-back by rfalWorker(): the next one is started as soon
+    *  as the previous one completes, without returning to the caller.
+    *  The result is stored in \a entry which must remain valid until its
+    *  status is no longer ERR_BUSY.
+    *  Starting another transceive while the queue runs stalls the queue
+    *  until rfalTransceiveQueueClear() is called.
+    *
+    *  \param[in,out] entry : transceive to be queued and its result slot
+    *
+    *  \return ERR_PARAM : Invalid parameter
+    *  \return ERR_NOMEM : Queue full
+    *  \return ERR_NONE  : Transceive queued
+    *****************************************************************************
+    */
+    ReturnCode rfalTransceiveQueueAdd(rfalTransceiveQueueEntry *entry);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Get the number of queued transceives, the running one included
+    *****************************************************************************
+    */
+    uint8_t rfalTransceiveQueueGetCount(void);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Clear the transceive queue
+    *
+    *  Entries not yet started are completed with ERR_REQUEST, the running one
+    *  (if any) completes normally.
+    *****************************************************************************
+    */
+    void rfalTransceiveQueueClear(void);
+
+#if ST25R200_FEATURE_PROFILER
+    /*!
+    *****************************************************************************
+    *  \brief  Reset the transceive profiler statistics
+    *****************************************************************************
+    */
+    void rfalProfReset(void);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Get the time spent in a transceive state
+    *
+    *  A sample is taken every time the transceive state machine leaves
+    *  \a state; states crossed within a single worker run are accounted to
+    *  the state the run started in.
+    *  E.g. TX_WAIT_GT and TX_WAIT_FDT give the guard time and FDT Poll waits,
+    *  TX_WAIT_TXE and RX_WAIT_RXE the RF time, TX_RELOAD_FIFO and
+    *  RX_READ_FIFO the bus time.
+    *
+    *  \param[in] state : transceive state
+    *
+    *  \return statistic of the state, NULL if the state is not tracked
+    *****************************************************************************
+    */
+    const rfalProfStat *rfalProfGetStateStat(rfalTransceiveState state);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Get the duration of whole transceives performed in a mode
+    *
+    *  \param[in] mode : RFAL mode
+    *
+    *  \return statistic of the mode, NULL if the mode is not tracked
+    *****************************************************************************
+    */
+    const rfalProfStat *rfalProfGetModeStat(rfalMode mode);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Get the latency from an interrupt being latched to its retrieval
+    *           by the state machines (st25r200GetInterrupt())
+    *
+    *  In deferred interrupt mode the latency starts on the IRQ line assertion.
+    *****************************************************************************
+    */
+    const rfalProfStat *rfalProfGetIrqStat(void);
+#endif /* ST25R200_FEATURE_PROFILER */
+
+#if ST25R200_FEATURE_ADAPTIVE_FWT
+    /*!
+    *****************************************************************************
+    *  \brief  Enable or disable the adaptive FWT
+    *
+    *  When enabled, the time from the end of transmission to the start of the
+    *  response is learned per mode and command class. Once enough responses
+    *  have been observed, the FWT given on a transceive is shrunk to 1.5 times
+    *  the decaying maximum of the learned response times plus a margin, so
+    *  that a tag which stops answering is detected after the learned FWT.
+    *  A timeout with a shrunk FWT is reported as ERR_TIMEOUT and drops the
+    *  responses learned for the mode and class: the following transceives
+    *  use the given FWT until enough responses are learned again.
+    *
+    *  \param[in] enable : true to enable, false to use the given FWT
+    *****************************************************************************
+    */
+    void rfalAdaptiveFwtEnable(bool enable);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Set the command class of the following transceives
+    *
+    *  Commands with different response times (e.g. inventory vs. write) are
+    *  to be given different classes so that they are learned separately.
+    *
+    *  \param[in] cls : command class, below RFAL_AFWT_CLASSES
+    *
+    *  \return ERR_PARAM : Invalid class
+    *  \return ERR_NONE  : Class set
+    *****************************************************************************
+    */
+    ReturnCode rfalAdaptiveFwtSetClass(uint8_t cls);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Forget all learned response times
+    *****************************************************************************
+    */
+    void rfalAdaptiveFwtReset(void);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Get the learned response time of a mode and command class
+    *
+    *  \param[in] mode : RFAL mode
+    *  \param[in] cls  : command class
+    *
+    *  \return learned response time in 1/fc, 0 if not learned yet
+    *****************************************************************************
+    */
+    uint32_t rfalAdaptiveFwtGet(rfalMode mode, uint8_t cls);
+#endif /* ST25R200_FEATURE_ADAPTIVE_FWT */
+
+
+    /*!
+    *****************************************************************************
+    *  \brief  Set the retry policy of the following transceives
+    *
+    *  A transceive failing with one of the errors of \a policy is restarted
+    *  by the worker from its transmission, without the caller starting a
+    *  new transceive: the timings and flags already programmed are kept,
+    *  the FIFO is loaded again after the delay of \a policy.
+    *  Transceives without transmission and streaming receives are not
+    *  retried.
+    *
+    *  \param[in] policy : retry policy, NULL to disable retries
+    *****************************************************************************
+    */
+    void rfalSetTransceiveRetryPolicy(const rfalTransceiveRetryPolicy *policy);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Get the number of attempts made by the last transceive
+    *****************************************************************************
+    */
+    uint8_t rfalGetTransceiveAttempts(void);
+
     rfalTransceiveState rfalGetTransceiveState(void);
     ReturnCode rfalGetTransceiveStatus(void);
     bool rfalIsTransceiveInTx(void);
@@ -483,13 +991,16 @@ class RfalRfST25R200Class : public RfalRfClass {
     *
     * Writes the Analog Configuration and Look Up Table with the given raw table
     *
-    * NOTE: Function does not check the validity of the given Table contents
+    * The table is copied into a RAM buffer and put in use, in place of the
+    * current one, as soon as no transceive is ongoing: immediately or by
+    * rfalWorker(). The current table stays in use until then.
     *
     * \param[in]  configTbl     : location of config Table to be loaded
     * \param[in]  configTblSize : size of the config Table to be loaded
     *
     * \return ERR_NONE    : if setting is updated
-    * \return ERR_PARAM   : if configTbl is invalid
+    * \return ERR_PARAM   : if configTbl is invalid, a Configuration ID
+    *                       exceeds the table or a register is invalid
     * \return ERR_NOMEM   : if the given Table is bigger exceeds the max size
     * \return ERR_REQUEST : if the update Configuration Id is disabled
     *
@@ -505,7 +1016,9 @@ class RfalRfST25R200Class : public RfalRfClass {
     * Writes the Analog Configuration and Look Up Table with the new list of register-mask-value
     * and Configuration ID respectively.
     *
-    * NOTE: Function does not check for the validity of the Register Address.
+    * The list is built in a RAM buffer, the current table staying in use.
+    * Once the last Configuration ID is written, the list is put in use as
+    * rfalAnalogConfigListWriteRaw() does. An error aborts the list.
     *
     * \param[in]  more    : 0x00 indicates it is last Configuration ID settings;
     *                       0x01 indicates more Configuration ID setting(s) are coming.
@@ -1509,6 +2022,22 @@ class RfalRfST25R200Class : public RfalRfClass {
     */
     uint32_t st25r200WaitForInterruptsTimed(uint32_t mask, uint16_t tmo);
 
+    /*!
+    *****************************************************************************
+    *  \brief  Wait until an ST25R200 interrupt occurs, timeout in microseconds
+    *
+    *  Same as st25r200WaitForInterruptsTimed() with \a tmo given in
+    *  microseconds, 0 waiting forever.
+    *
+    *  \param[in] mask : mask indicating the interrupts to wait for.
+    *  \param[in] tmo  : time in microseconds until timeout occurs
+    *
+    *  \return : 0 if timeout occurred otherwise a mask indicating the cleared
+    *              interrupts.
+    *****************************************************************************
+    */
+    uint32_t st25r200WaitForInterruptsTimedUs(uint32_t mask, uint32_t tmo);
+
     /*!
     *****************************************************************************
     *  \brief  Get status for the given interrupt
@@ -1562,10 +2091,42 @@ class RfalRfST25R200Class : public RfalRfClass {
     *  \brief  ISR Service routine
     *
     *  This function modiefies the interrupt
+    *  With ST25R200_FEATURE_DEFERRED_IRQ it only queues a timestamped event,
+    *  the interrupt status is retrieved by st25r200IrqEvtProcess()
     *****************************************************************************
     */
     void  st25r200Isr(void);
 
+    /*!
+    *****************************************************************************
+    *  \brief  Process the deferred IRQ events
+    *
+    *  Consumes the events queued by st25r200Isr() and retrieves the interrupt
+    *  status from the chip. Called by rfalWorker() and while waiting for
+    *  interrupts; does nothing unless ST25R200_FEATURE_DEFERRED_IRQ is enabled.
+    *****************************************************************************
+    */
+    void st25r200IrqEvtProcess(void);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Get the time of the last IRQ event processed
+    *
+    *  \return timerGetTimeUs() at the time the IRQ line was asserted for the last
+    *          event processed by st25r200IrqEvtProcess()
+    *****************************************************************************
+    */
+    uint32_t st25r200IrqEvtGetLastTimestamp(void);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Get the number of IRQ events dropped on a full event ring
+    *
+    *  \return number of events dropped
+    *****************************************************************************
+    */
+    uint32_t st25r200IrqEvtGetDropped(void);
+
     /*!
     *****************************************************************************
     *  \brief  Enable a given ST25R200 Interrupt source
@@ -1739,6 +2300,142 @@ class RfalRfST25R200Class : public RfalRfClass {
     */
     ReturnCode st25r200ReadFifo(uint8_t *buf, uint16_t length);
 
+    /*!
+    *****************************************************************************
+    *  \brief  Set the asynchronous FIFO transfer hook
+    *
+    *  Registers the function used to perform FIFO data transfers without
+    *  blocking (e.g. by means of DMA). Passing NULL restores blocking transfers.
+    *
+    *  \param[in]  hook: transfer hook, or NULL
+    *  \param[in]  ctx : context handed over to the hook
+    *
+    *  \return ERR_NONE    : Hook set
+    *  \return ERR_TIMEOUT : Ongoing transfer aborted, hook not set
+    *****************************************************************************
+    */
+    ReturnCode st25r200SetFifoXferHook(st25r200FifoXferHook hook, void *ctx);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Start writing values to ST25R200 FIFO
+    *
+    *  Same as st25r200WriteFifo() but returns as soon as the transfer has been
+    *  started. The buffer must remain valid until st25r200FifoXferIsBusy()
+    *  returns false. Short transfers, or transfers without a hook registered,
+    *  are performed blocking.
+    *
+    *  \param[in]  values: pointer to a buffer containing the values to be written
+    *                      to the FIFO
+    *  \param[in]  length: Number of values to be written
+    *
+    *  \return ERR_NONE    : Operation successfully started
+    *  \return ERR_PARAM   : Invalid parameter
+    *  \return ERR_TIMEOUT : Previous asynchronous transfer aborted
+    *****************************************************************************
+    */
+    ReturnCode st25r200WriteFifoStart(const uint8_t *values, uint16_t length);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Start reading values from ST25R200 FIFO
+    *
+    *  Same as st25r200ReadFifo() but returns as soon as the transfer has been
+    *  started. The buffer content is valid once st25r200FifoXferIsBusy()
+    *  returns false. Short transfers, or transfers without a hook registered,
+    *  are performed blocking.
+    *
+    *  \param[out] buf   : pointer to a buffer where the FIFO content shall be
+    *                      written to, NULL to discard
+    *  \param[in]  length: Number of bytes to read
+    *
+    *  \return ERR_NONE    : Operation successfully started
+    *  \return ERR_PARAM   : Invalid parameter
+    *  \return ERR_TIMEOUT : Previous asynchronous transfer aborted
+    *****************************************************************************
+    */
+    ReturnCode st25r200ReadFifoStart(uint8_t *buf, uint16_t length);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Signal the completion of an asynchronous FIFO transfer
+    *
+    *  To be called by the transfer hook implementation once the data phase
+    *  has completed. May be called from interrupt context.
+    *****************************************************************************
+    */
+    void st25r200FifoXferDone(void);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Get the bus transport
+    *
+    *  Gives access to the transport in use, e.g. to retrieve its byte counters.
+    *
+    *  \return the bus transport
+    *****************************************************************************
+    */
+    ST25R200Transport *st25r200GetTransport(void);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Read the FIFO status followed by the FIFO content
+    *
+    *  Reads the FIFO status registers and, within the same bus transaction,
+    *  the bytes available in the FIFO up to \a maxLen.
+    *  Intended to retrieve a complete frame upon end of reception.
+    *
+    *  \param[out] status: buffer of ST25R200_FIFO_STATUS_LEN bytes for the
+    *                      FIFO status registers
+    *  \param[out] buf   : pointer to a buffer where the FIFO content shall be
+    *                      written to
+    *  \param[in]  maxLen: Max number of bytes to read
+    *  \param[out] rdLen : Number of bytes read
+    *
+    *  \return ERR_NONE  : Operation successful
+    *  \return ERR_PARAM : Invalid parameter
+    *****************************************************************************
+    */
+    ReturnCode st25r200ReadFifoFrame(uint8_t *status, uint8_t *buf, uint16_t maxLen, uint16_t *rdLen);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Check whether an asynchronous FIFO transfer is ongoing
+    *
+    *  Completes the bus transaction once the transfer hook has signalled
+    *  the end of the data phase. A transfer not completed within
+    *  ST25R200_FIFO_XFER_TOUT_US is aborted and the next access to the
+    *  chip reports ERR_TIMEOUT.
+    *
+    *  \return true  : Transfer ongoing, the bus is not available
+    *  \return false : No transfer ongoing
+    *****************************************************************************
+    */
+    bool st25r200FifoXferIsBusy(void);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Open a bus session
+    *
+    *  Locks and configures the bus once, on the first access, for all the
+    *  accesses performed until the session is closed. A session without any
+    *  access leaves the bus alone. Interrupts raised meanwhile are served
+    *  when the session closes. Sessions can be nested.
+    *  Prefer ST25R200BusSession which closes the session on scope exit.
+    *****************************************************************************
+    */
+    void st25r200SessionBegin(void);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Close a bus session
+    *
+    *  Releases the bus once the outermost session is closed and serves the
+    *  interrupt deferred while the session was open.
+    *****************************************************************************
+    */
+    void st25r200SessionEnd(void);
+
     /*!
     *****************************************************************************
     *  \brief  Execute a direct command
@@ -1920,6 +2617,65 @@ class RfalRfST25R200Class : public RfalRfClass {
     */
     bool st25r200IsRegValid(uint8_t reg);
 
+    /*!
+    *****************************************************************************
+    *  \brief  Invalidate the register shadow
+    *
+    *  Marks every bit of the configuration register shadow as unknown, so
+    *  that the next read-modify-write fetches the value from the ST25R200
+    *  and no register change is skipped as already in place.
+    *  Must be called whenever the chip may have been reset behind the driver.
+    *
+    *****************************************************************************
+    */
+    void st25r200ShadowInvalidate(void);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Open a register batch
+    *
+    *  Starts queueing register changes instead of executing them one by one.
+    *  While a batch is open, register writes and read-modify-writes are queued,
+    *  register reads return the chip content with the queued changes applied
+    *  and direct commands flush the queue before being executed.
+    *  Batches can be nested, the changes are flushed by the outermost commit.
+    *
+    *****************************************************************************
+    */
+    void st25r200BatchBegin(void);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Queue a register change
+    *
+    *  Queues the change of the bits given by \a valueMask of register \a reg
+    *  to \a value. Changes to the same register are merged.
+    *  If no batch is open the change is executed immediately.
+    *
+    *  \param[in]  reg      : Address of the register to change
+    *  \param[in]  valueMask: Bits to be changed
+    *  \param[in]  value    : New value of the bits to be changed
+    *
+    *  \return ERR_NONE  : Operation successful
+    *  \return ERR_PARAM : Invalid register
+    *****************************************************************************
+    */
+    ReturnCode st25r200BatchQueue(uint8_t reg, uint8_t valueMask, uint8_t value);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Commit a register batch
+    *
+    *  Closes the current batch. When the outermost batch is closed the queued
+    *  changes are sorted by address and contiguous registers are written with
+    *  a single burst access.
+    *
+    *  \return ERR_NONE  : Operation successful
+    *  \return ERR_WRONG_STATE : No batch open
+    *****************************************************************************
+    */
+    ReturnCode st25r200BatchCommit(void);
+
 
     /*
     ******************************************************************************
@@ -1946,6 +2702,45 @@ class RfalRfST25R200Class : public RfalRfClass {
     uint32_t timerCalculateTimer(uint16_t time);
 
 
+    /*!
+    *****************************************************************************
+    * \brief  Calculate Timer in microseconds
+    *
+    * Same as timerCalculateTimer() with a duration given in microseconds.
+    * Durations up to 2^31 us (~35min) are supported.
+    *
+    * \param[in]  time : time/duration in Microseconds for the timer
+    *
+    * \return u32 : The new timer calculated based on the given time
+    *****************************************************************************
+    */
+    uint32_t timerCalculateTimerUs(uint32_t time);
+
+
+    /*!
+    *****************************************************************************
+    * \brief  Set the time source of the software timers
+    *
+    * The timers are based on micros() by default. A finer or cheaper source
+    * can be provided instead, e.g. derived from the DWT cycle counter or from
+    * a host steady clock.
+    *
+    * \param[in]  src : microsecond time source, NULL restores micros()
+    *****************************************************************************
+    */
+    void timerSetTimeSource(st25r200TimeSource src);
+
+
+    /*!
+    *****************************************************************************
+    * \brief  Get the current time
+    *
+    * \return the time of the software timers time source in us
+    *****************************************************************************
+    */
+    uint32_t timerGetTimeUs(void);
+
+
     /*!
     *****************************************************************************
     * \brief  Checks if a Timer is Expired
@@ -2002,13 +2797,24 @@ class RfalRfST25R200Class : public RfalRfClass {
 
 
   protected:
+    void rfalInitInstance(void);
     ReturnCode rfalTransceiveRunBlockingTx(void);
     ReturnCode rfalRunTransceiveWorker(void);
     void rfalErrorHandling(void);
     void rfalCleanupTransceive(void);
     void rfalPrepareTransceive(void);
+    void rfalPrepareFDTPoll(void);
+    void rfalPrepareTransceiveFlags(void);
+    void rfalApplyTransceiveFlags(uint8_t tx1, uint8_t rx1, uint8_t rxDig, uint8_t nrtGpt);
+    void rfalRestoreTransceiveFlags(void);
+    void rfalSetMaskReceiveTime(uint8_t mrt);
+    const rfalModeDesc *rfalGetModeDesc(rfalMode mode);
+    void rfalTransceiveTxLoad(bool overlapFdt);
+    void rfalTransceiveTxWrite(uint16_t offset, uint16_t length);
+    bool rfalTransceiveRetry(void);
     void rfalTransceiveTx(void);
     void rfalTransceiveRx(void);
+    bool rfalTransceiveFifoBusy(rfalTransceiveState failState);
     void rfalFIFOStatusUpdate(void);
     void rfalFIFOStatusClear(void);
     uint16_t rfalFIFOStatusGetNumBytes(void);
@@ -2018,27 +2824,137 @@ class RfalRfST25R200Class : public RfalRfClass {
 #if RFAL_FEATURE_WAKEUP_MODE
     void rfalRunWakeUpModeWorker(void);
 #endif /* RFAL_FEATURE_WAKEUP_MODE */
+    void rfalTransceiveAsyncComplete(void);
+#if ST25R200_FEATURE_RX_STREAM
+    void rfalRxStreamRead(uint16_t length, uint16_t hold);
+    void rfalRxStreamDeliver(uint16_t upTo);
+    uint16_t rfalRxStreamHold(void);
+#endif /* ST25R200_FEATURE_RX_STREAM */
+    void rfalTransceiveQueueNext(void);
+    static void rfalTransceiveQueueDone(void *cbCtx, ReturnCode status, uint16_t rxLen);
+#if ST25R200_FEATURE_ADAPTIVE_FWT
+    uint32_t rfalAdaptiveFwtApply(uint32_t fwt);
+    void rfalAdaptiveFwtLearn(void);
+    void rfalAdaptiveFwtIrq(uint32_t irqs, uint32_t ts);
+#endif /* ST25R200_FEATURE_ADAPTIVE_FWT */
+#if ST25R200_FEATURE_PROFILER
+    void rfalProfUpdate(void);
+    rfalProfStat *rfalProfStateStat(rfalTransceiveState state);
+    void rfalProfSample(rfalProfStat *stat, uint32_t us);
+#endif /* ST25R200_FEATURE_PROFILER */
 
 
     ReturnCode st25r200WaitAgd(void);
+    ReturnCode st25r200ShadowReadRegister(uint8_t reg, uint8_t *val);
+    void st25r200ShadowUpdate(uint8_t reg, const uint8_t *values, uint16_t length);
+    bool st25r200ShadowHolds(uint8_t reg, uint8_t mask, uint8_t val);
+    ReturnCode st25r200UpdateRegisterBits(uint8_t reg, uint8_t valueMask, uint8_t value);
+    ReturnCode st25r200BatchFlush(void);
+    void st25r200BatchOverlay(uint8_t reg, uint8_t *values, uint16_t length);
+    ReturnCode st25r200FifoXferStart(uint8_t header, const uint8_t *txData, uint8_t *rxData, uint16_t length);
+    ReturnCode st25r200FifoXferWait(void);
+    void st25r200SessionLock(void);
+    void st25r200IsrHandle(void);
+    ReturnCode st25r200IsrAttach(void);
+    void st25r200IsrDetach(void);
+
+    /*! Interrupt entry point of dispatch slot \a slot, forwards to the instance bound to it */
+    template <uint8_t slot>
+    static void st25r200IsrDispatch(void)
+    {
+      RfalRfST25R200Class *inst = st25r200IsrInstance[slot];
+
+      if (inst != NULL) {
+        inst->st25r200Isr();
+      }
+    }
+
+    static RfalRfST25R200Class *volatile st25r200IsrInstance[ST25R200_IRQ_DISPATCH_SLOTS]; /*!< Instance bound to each dispatch slot */
+    static int st25r200IsrPin[ST25R200_IRQ_DISPATCH_SLOTS];                               /*!< Interrupt pin of each dispatch slot  */
+    static const ST25R200IrqHandler st25r200IsrDispatchTbl[ST25R200_IRQ_DISPATCH_SLOTS];  /*!< Entry point of each dispatch slot    */
+    void st25r200IsrServePending(void);
+    bool st25r200IrqEvtPop(st25r200IrqEvt *evt);
     rfalAnalogConfigNum rfalAnalogConfigSearch(rfalAnalogConfigId configId, uint16_t *configOffset);
+#if ST25R200_FEATURE_ANALOG_INDEX
+    uint8_t rfalAnalogConfigIndexSlot(rfalAnalogConfigId configId);
+    void rfalAnalogConfigIndexBuild(void);
+#endif /* ST25R200_FEATURE_ANALOG_INDEX */
+    void rfalAnalogConfigSwap(void);
+#if ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG
+    bool rfalAnalogConfigTblCheck(const uint8_t *tbl, uint16_t tblSize);
+    uint8_t *rfalAnalogConfigShadowTbl(void);
+#endif /* ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG */
     uint16_t rfalCrcUpdateCcitt(uint16_t crcSeed, uint8_t dataByte);
 
 
-    SPIClass *dev_spi;
-    int cs_pin;
+    ST25R200SpiTransport spiTransport;  /*!< SPI transport used when none is given */
+    ST25R200Transport *transport;      /*!< Transport to access the ST25R200     */
     int int_pin;
     int reset_pin;
-    uint32_t spi_speed;
 
     rfal gRFAL;              /*!< RFAL module instance               */
+    rfalTxRxQueue gRfalTxRxQueue;  /*!< Transceive queue           */
+#if ST25R200_FEATURE_PROFILER
+    rfalProfiler gRfalProf;        /*!< Transceive profiler        */
+#endif /* ST25R200_FEATURE_PROFILER */
+#if ST25R200_FEATURE_ADAPTIVE_FWT
+    rfalAdaptiveFwt gRfalAfwt;     /*!< Adaptive FWT engine        */
+#endif /* ST25R200_FEATURE_ADAPTIVE_FWT */
     rfalAnalogConfigMgmt   gRfalAnalogConfigMgmt;  /*!< Analog Configuration LUT management */
+#if ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG
+    uint8_t gRfalAnalogConfigRam[2][RFAL_ANALOG_CONFIG_TBL_SIZE];  /*!< Analog Configuration tables loaded at runtime, one in use and one being prepared */
+#endif /* ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG */
     rfalIso15693PhyConfig_t rfalIso15693PhyConfig; /*!< current phy configuration */
     uint32_t gST25R200NRT_64fcs;
+    st25r200ShadowRegs st25r200Shadow;            /*!< Shadow of the ST25R200 configuration registers */
+#if ST25R200_FEATURE_REG_BATCH
+    st25r200RegBatch st25r200Batch;               /*!< Register changes queued by the open batch      */
+#endif /* ST25R200_FEATURE_REG_BATCH */
+#if ST25R200_FEATURE_FIFO_ASYNC
+    st25r200FifoXfer st25r200Xfer;                /*!< Asynchronous FIFO transfer state               */
+#endif /* ST25R200_FEATURE_FIFO_ASYNC */
+#if ST25R200_FEATURE_BUS_SESSION
+    volatile uint8_t st25r200SessionDepth;        /*!< Nesting level of the open bus sessions         */
+    bool st25r200SessionLocked;                   /*!< Bus locked on behalf of the open sessions      */
+#endif /* ST25R200_FEATURE_BUS_SESSION */
     volatile st25r200Interrupt st25r200interrupt; /*!< Instance of ST25R200 interrupt */
+#if ST25R200_FEATURE_DEFERRED_IRQ
+    st25r200IrqRing st25r200IrqEvts;              /*!< IRQ events queued by the hardware handler      */
+#endif /* ST25R200_FEATURE_DEFERRED_IRQ */
     uint32_t timerStopwatchTick;
+    st25r200TimeSource timerSource;    /*!< Time source of the SW timers, NULL for micros() */
     volatile bool isr_pending;
     ST25R200IrqHandler irq_handler;
+    uint8_t irq_slot;                  /*!< Dispatch slot in use, ST25R200_IRQ_DISPATCH_SLOTS if none */
+};
+
+
+/*! Scoped bus session: the bus is locked by the first access within the scope and released on destruction
+ *
+ *  \code
+ *  {
+ *    ST25R200BusSession session(rfal);
+ *    ...consecutive register accesses...
+ *  }
+ *  \endcode
+ */
+class ST25R200BusSession {
+  public:
+    explicit ST25R200BusSession(RfalRfST25R200Class *rf) : rf(rf)
+    {
+      rf->st25r200SessionBegin();
+    }
+
+    ~ST25R200BusSession()
+    {
+      rf->st25r200SessionEnd();
+    }
+
+  private:
+    ST25R200BusSession(const ST25R200BusSession &);
+    ST25R200BusSession &operator=(const ST25R200BusSession &);
+
+    RfalRfST25R200Class *rf;
 };
 
 #ifdef __cplusplus
@@ -48,6 +48,8 @@
 
 #define RFAL_TEST_REG         0x0080U      /*!< Test Register indicator  */
 
+#define RFAL_ANALOG_CONFIG_IDX_BUCKET(id, slot)  ((uint16_t)((((id) & RFAL_ANALOG_CONFIG_POLL_LISTEN_MODE_MASK) >> 8U) | (((id) & RFAL_ANALOG_CONFIG_BITRATE_MASK) >> 1U) | (slot)))  /*!< Index bucket of an ID for a technology slot */
+
 /*
  ******************************************************************************
  * LOCAL TABLES
@@ -78,9 +80,19 @@ void RfalRfST25R200Class::rfalAnalogConfigInitialize(void)
   /* Use default Analog configuration settings in Flash by default. */
 
   /* Check whether the Default Analog settings are to be used or custom ones */
-  gRfalAnalogConfigMgmt.currentAnalogConfigTbl = (const uint8_t *)&rfalAnalogConfigDefaultSettings;
-  gRfalAnalogConfigMgmt.configTblSize          = sizeof(rfalAnalogConfigDefaultSettings);
+  gRfalAnalogConfigMgmt.currentAnalogConfigTbl = rfalAnalogConfigDefaultSettings.data;
+  gRfalAnalogConfigMgmt.configTblSize          = sizeof(rfalAnalogConfigDefaultSettings.data);
+
+#if ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG
+  /* Drop any table being prepared */
+  gRfalAnalogConfigMgmt.shadowTblSize = 0U;
+  gRfalAnalogConfigMgmt.shadowOpen    = false;
+  gRfalAnalogConfigMgmt.swapPending   = false;
+#endif /* ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG */
 
+#if ST25R200_FEATURE_ANALOG_INDEX
+  rfalAnalogConfigIndexBuild();
+#endif /* ST25R200_FEATURE_ANALOG_INDEX */
 
   gRfalAnalogConfigMgmt.ready = true;
 }
@@ -96,20 +108,88 @@ bool RfalRfST25R200Class::rfalAnalogConfigIsReady(void)
 /*******************************************************************************/
 ReturnCode RfalRfST25R200Class::rfalAnalogConfigListWriteRaw(const uint8_t *configTbl, uint16_t configTblSize)
 {
+#if ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG
+  /* Check for invalid parameters */
+  if ((configTbl == NULL) || (configTblSize == 0U)) {
+    return ERR_PARAM;
+  }
+
+  /* Check if the Configuration Table exceeds the Table size */
+  if (configTblSize > RFAL_ANALOG_CONFIG_TBL_SIZE) {
+    return ERR_NOMEM;
+  }
+
+  if (!rfalAnalogConfigTblCheck(configTbl, configTblSize)) {
+    return ERR_PARAM;
+  }
+
+  /* Prepare the table in the buffer not in use, an ongoing list is dropped */
+  ST_MEMCPY(rfalAnalogConfigShadowTbl(), configTbl, configTblSize);
+  gRfalAnalogConfigMgmt.shadowTblSize = configTblSize;
+  gRfalAnalogConfigMgmt.shadowOpen    = false;
+  gRfalAnalogConfigMgmt.swapPending   = true;
+
+  rfalAnalogConfigSwap();
+
+  return ERR_NONE;
+#else
   // If Analog Configuration Update is to be disabled
   NO_WARNING(configTbl);
   NO_WARNING(configTblSize);
   return ERR_REQUEST;
+#endif /* ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG */
 }
 
 
 /*******************************************************************************/
 ReturnCode RfalRfST25R200Class::rfalAnalogConfigListWrite(uint8_t more, const rfalAnalogConfig *config)
 {
+#if ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG
+  uint16_t configSize;
+
+  if (config == NULL) {
+    return ERR_PARAM;
+  }
+
+  /* First Configuration ID of a list, start from an empty table. A table still pending is dropped */
+  if (!gRfalAnalogConfigMgmt.shadowOpen) {
+    gRfalAnalogConfigMgmt.shadowTblSize = 0U;
+    gRfalAnalogConfigMgmt.shadowOpen    = true;
+    gRfalAnalogConfigMgmt.swapPending   = false;
+  }
+
+  configSize = (uint16_t)(sizeof(rfalAnalogConfigId) + sizeof(rfalAnalogConfigNum) + (config->num * sizeof(rfalAnalogConfigRegAddrMaskVal)));
+
+  /* Check Table limits */
+  if ((gRfalAnalogConfigMgmt.shadowTblSize + configSize) > RFAL_ANALOG_CONFIG_TBL_SIZE) {
+    gRfalAnalogConfigMgmt.shadowOpen = false;
+    return ERR_NOMEM;
+  }
+
+  if (!rfalAnalogConfigTblCheck((const uint8_t *)config, configSize)) {
+    gRfalAnalogConfigMgmt.shadowOpen = false;
+    return ERR_PARAM;
+  }
+
+  /* Append the Configuration ID, its number of sets and the sets */
+  ST_MEMCPY(&rfalAnalogConfigShadowTbl()[gRfalAnalogConfigMgmt.shadowTblSize], (const uint8_t *)config, configSize);
+  gRfalAnalogConfigMgmt.shadowTblSize += configSize;
+
+  /* Last Configuration ID, the list is complete */
+  if (more == RFAL_ANALOG_CONFIG_UPDATE_LAST) {
+    gRfalAnalogConfigMgmt.shadowOpen  = false;
+    gRfalAnalogConfigMgmt.swapPending = true;
+
+    rfalAnalogConfigSwap();
+  }
+
+  return ERR_NONE;
+#else
   // If Analog Configuration Update is to be disabled
   NO_WARNING(config);
   NO_WARNING(more);
   return ERR_DISABLED;
+#endif /* ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG */
 }
 
 
@@ -175,39 +255,55 @@ ReturnCode RfalRfST25R200Class::rfalSetAnalogConfig(rfalAnalogConfigId configId)
   rfalAnalogConfigNum numConfigSet;
   rfalAnalogConfigRegAddrMaskVal *configTbl;
   ReturnCode retCode = ERR_NONE;
+  ReturnCode retCommit;
   rfalAnalogConfigNum i;
 
   if (true != gRfalAnalogConfigMgmt.ready) {
     return ERR_REQUEST;
   }
 
+  /* Keep the bus for all the accesses of the configuration */
+  ST25R200BusSession session(this);
+
+  /* Queue the register changes, contiguous registers are written in bursts on commit */
+  st25r200BatchBegin();
+
   /* Search LUT for the specific Configuration ID */
-  while (true) {
+  while (retCode == ERR_NONE) {
     numConfigSet = rfalAnalogConfigSearch(configId, &configOffset);
     if (RFAL_ANALOG_CONFIG_LUT_NOT_FOUND == numConfigSet) {
       break;
     }
 
-    configTbl = (rfalAnalogConfigRegAddrMaskVal *)((uint32_t)gRfalAnalogConfigMgmt.currentAnalogConfigTbl + (uint32_t)configOffset);
+    configTbl = (rfalAnalogConfigRegAddrMaskVal *)(&gRfalAnalogConfigMgmt.currentAnalogConfigTbl[configOffset]);
     /* Increment the offset to the next index to search from */
     configOffset += (uint16_t)(numConfigSet * sizeof(rfalAnalogConfigRegAddrMaskVal));
 
     if ((gRfalAnalogConfigMgmt.configTblSize + 1U) < configOffset) {
       /* Error check make sure that the we do not access outside the configuration Table Size */
-      return ERR_NOMEM;
+      retCode = ERR_NOMEM;
+      break;
     }
 
-    for (i = 0; i < numConfigSet; i++) {
+    for (i = 0; (i < numConfigSet) && (retCode == ERR_NONE); i++) {
       if ((GETU16(configTbl[i].addr) & RFAL_TEST_REG) != 0U) {
-        EXIT_ON_ERR(retCode, rfalChipChangeTestRegBits((GETU16(configTbl[i].addr) & ~RFAL_TEST_REG), configTbl[i].mask, configTbl[i].val));
-      } else {
-        EXIT_ON_ERR(retCode, rfalChipChangeRegBits(GETU16(configTbl[i].addr), configTbl[i].mask, configTbl[i].val));
+        retCode = rfalChipChangeTestRegBits((GETU16(configTbl[i].addr) & ~RFAL_TEST_REG), configTbl[i].mask, configTbl[i].val);
+      }
+#if ST25R200_FEATURE_ANALOG_DELTA
+      else if (st25r200ShadowHolds((uint8_t)GETU16(configTbl[i].addr), configTbl[i].mask, configTbl[i].val)) {
+        /* Bits already set to these values on the chip, nothing to change */
+      }
+#endif /* ST25R200_FEATURE_ANALOG_DELTA */
+      else {
+        retCode = rfalChipChangeRegBits(GETU16(configTbl[i].addr), configTbl[i].mask, configTbl[i].val);
       }
     }
 
   } /* while(found Analog Config Id) */
 
-  return retCode;
+  retCommit = st25r200BatchCommit();
+
+  return ((retCode != ERR_NONE) ? retCode : retCommit);
 }
 
 
@@ -263,12 +359,98 @@ uint16_t RfalRfST25R200Class::rfalAnalogConfigGenModeID(rfalMode md, rfalBitRate
   return id;
 }
 
+/*******************************************************************************/
+void RfalRfST25R200Class::rfalAnalogConfigSwap(void)
+{
+#if ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG
+  /* The table is only swapped between transceives */
+  if ((!gRfalAnalogConfigMgmt.swapPending) || ((gRFAL.state == RFAL_STATE_TXRX) && (gRFAL.TxRx.state != RFAL_TXRX_STATE_IDLE))) {
+    return;
+  }
+
+  gRfalAnalogConfigMgmt.currentAnalogConfigTbl = rfalAnalogConfigShadowTbl();
+  gRfalAnalogConfigMgmt.configTblSize          = gRfalAnalogConfigMgmt.shadowTblSize;
+  gRfalAnalogConfigMgmt.ready                  = true;
+  gRfalAnalogConfigMgmt.swapPending            = false;
+  gRfalAnalogConfigMgmt.shadowTblSize          = 0U;
+
+#if ST25R200_FEATURE_ANALOG_INDEX
+  rfalAnalogConfigIndexBuild();
+#endif /* ST25R200_FEATURE_ANALOG_INDEX */
+#endif /* ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG */
+}
+
+
 /*
  ******************************************************************************
  * LOCAL FUNCTIONS
  ******************************************************************************
  */
 
+#if ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG
+
+/*!
+ *****************************************************************************
+ * \brief  Check an Analog Configuration table
+ *
+ * Checks that the Register-Mask-Value sets of every Configuration ID end
+ * within the table and that every register is a valid one.
+ *
+ * \param[in]  tbl     : table in raw format
+ * \param[in]  tblSize : size of the table
+ *
+ * \return true if the table can be used
+ *****************************************************************************
+ */
+bool RfalRfST25R200Class::rfalAnalogConfigTblCheck(const uint8_t *tbl, uint16_t tblSize)
+{
+  uint16_t i;
+  uint16_t addr;
+  uint16_t setOffset;
+  uint8_t  num;
+  uint8_t  k;
+
+  i = 0U;
+  while (i < tblSize) {
+    if ((i + RFAL_ANALOG_CONFIG_TBL_HDR_LEN) > tblSize) {
+      return false;
+    }
+
+    num = tbl[i + sizeof(rfalAnalogConfigId)];
+    if ((i + RFAL_ANALOG_CONFIG_TBL_HDR_LEN + ((uint16_t)num * RFAL_ANALOG_CONFIG_TBL_SET_LEN)) > tblSize) {
+      return false;
+    }
+
+    for (k = 0U; k < num; k++) {
+      setOffset = (uint16_t)(i + RFAL_ANALOG_CONFIG_TBL_HDR_LEN + ((uint16_t)k * RFAL_ANALOG_CONFIG_TBL_SET_LEN));
+      addr      = GETU16(&tbl[setOffset]);
+
+      /* Registers and test registers share the same address range */
+      if (((addr & ~(RFAL_TEST_REG | 0x007FU)) != 0U) || (!st25r200IsRegValid((uint8_t)(addr & ~RFAL_TEST_REG)))) {
+        return false;
+      }
+    }
+
+    i += (uint16_t)(RFAL_ANALOG_CONFIG_TBL_HDR_LEN + ((uint16_t)num * RFAL_ANALOG_CONFIG_TBL_SET_LEN));
+  }
+
+  return true;
+}
+
+
+/*!
+ *****************************************************************************
+ * \brief  Get the RAM buffer not in use, where a new table is prepared
+ *****************************************************************************
+ */
+uint8_t *RfalRfST25R200Class::rfalAnalogConfigShadowTbl(void)
+{
+  return ((gRfalAnalogConfigMgmt.currentAnalogConfigTbl == gRfalAnalogConfigRam[0]) ? gRfalAnalogConfigRam[1] : gRfalAnalogConfigRam[0]);
+}
+
+#endif /* ST25R200_FEATURE_DYNAMIC_ANALOG_CONFIG */
+
+
 /*!
  *****************************************************************************
  * \brief  Search the Analog Configuration LUT for a specific Configuration ID.
@@ -302,6 +484,31 @@ rfalAnalogConfigNum RfalRfST25R200Class::rfalAnalogConfigSearch(rfalAnalogConfig
     configIdMaskVal = (RFAL_ANALOG_CONFIG_POLL_LISTEN_MODE_MASK | RFAL_ANALOG_CONFIG_TECH_MASK | RFAL_ANALOG_CONFIG_BITRATE_MASK | RFAL_ANALOG_CONFIG_DIRECTION_MASK);
   }
 
+#if ST25R200_FEATURE_ANALOG_INDEX
+  if (gRfalAnalogConfigMgmt.idx.valid) {
+    uint16_t bucket;
+    uint16_t pos;
+
+    /* Only the IDs sharing Poll/Listen, Bit rate and (one of) the technology can match */
+    bucket = RFAL_ANALOG_CONFIG_IDX_BUCKET(configId, rfalAnalogConfigIndexSlot(configId));
+    for (pos = gRfalAnalogConfigMgmt.idx.start[bucket]; pos < gRfalAnalogConfigMgmt.idx.start[bucket + 1U]; pos++) {
+      i = gRfalAnalogConfigMgmt.idx.offset[pos];
+      if (i < (*configOffset)) {
+        continue;                                   /* Already returned by a previous search */
+      }
+
+      configTbl = &currentConfigTbl[i];
+      foundConfigId = GETU16(configTbl);
+      if (configId == (foundConfigId & configIdMaskVal)) {
+        *configOffset = (uint16_t)(i + sizeof(rfalAnalogConfigId) + sizeof(rfalAnalogConfigNum));
+        return configTbl[sizeof(rfalAnalogConfigId)];
+      }
+    }
+
+    return RFAL_ANALOG_CONFIG_LUT_NOT_FOUND;
+  }
+#endif /* ST25R200_FEATURE_ANALOG_INDEX */
+
   i = (*configOffset);
   while (i < gRfalAnalogConfigMgmt.configTblSize) {
     configTbl = &currentConfigTbl[i];
@@ -319,3 +526,112 @@ rfalAnalogConfigNum RfalRfST25R200Class::rfalAnalogConfigSearch(rfalAnalogConfig
 
   return RFAL_ANALOG_CONFIG_LUT_NOT_FOUND;
 }
+
+
+#if ST25R200_FEATURE_ANALOG_INDEX
+
+/*!
+ *****************************************************************************
+ * \brief  Get the index technology slot of a Configuration ID
+ *
+ * \param[in]  configId: Configuration ID
+ *
+ * \return 0 for chip specific IDs, otherwise 1 + the lowest technology bit set
+ *****************************************************************************
+ */
+uint8_t RfalRfST25R200Class::rfalAnalogConfigIndexSlot(rfalAnalogConfigId configId)
+{
+  uint16_t tech;
+  uint8_t  slot;
+
+  tech = (RFAL_ANALOG_CONFIG_ID_GET_TECH(configId) >> RFAL_ANALOG_CONFIG_TECH_SHIFT);
+  if (tech == 0U) {
+    return 0U;
+  }
+
+  for (slot = 1U; (tech & 0x01U) == 0U; slot++) {
+    tech >>= 1U;
+  }
+  return slot;
+}
+
+
+/*!
+ *****************************************************************************
+ * \brief  Build the index of the current Analog Configuration LUT
+ *
+ * Lists the offset of every Configuration ID in the bucket of its Poll/Listen
+ * mode, Bit rate and of each of its technologies, keeping the table order.
+ * If the table holds more IDs than the index can list, the index is left
+ * invalid and the table is searched linearly.
+ *****************************************************************************
+ */
+void RfalRfST25R200Class::rfalAnalogConfigIndexBuild(void)
+{
+  rfalAnalogConfigIndex *idx;
+  const uint8_t         *tbl;
+  rfalAnalogConfigId    id;
+  uint16_t              i;
+  uint16_t              b;
+  uint16_t              total;
+  uint8_t               slot;
+  uint8_t               pass;
+  bool                  member;
+
+  idx = &gRfalAnalogConfigMgmt.idx;
+  tbl = gRfalAnalogConfigMgmt.currentAnalogConfigTbl;
+
+  idx->valid = false;
+  ST_MEMSET(idx->start, 0x00, sizeof(idx->start));
+
+  /* First pass counts the IDs of each bucket, second one lists their offsets */
+  for (pass = 0U; pass < 2U; pass++) {
+    total = 0U;
+    i     = 0U;
+    while ((i + sizeof(rfalAnalogConfigId) + sizeof(rfalAnalogConfigNum)) <= gRfalAnalogConfigMgmt.configTblSize) {
+      id = GETU16(&tbl[i]);
+
+      for (slot = 0U; slot < RFAL_ANALOG_CONFIG_IDX_TECHS; slot++) {
+        /* Chip specific IDs go to slot 0, the others to the slot of each technology bit set */
+        member = ((slot == 0U) ? (RFAL_ANALOG_CONFIG_ID_GET_TECH(id) == RFAL_ANALOG_CONFIG_TECH_CHIP)
+                  : ((RFAL_ANALOG_CONFIG_ID_GET_TECH(id) & (1U << (RFAL_ANALOG_CONFIG_TECH_SHIFT + slot - 1U))) != 0U));
+        if (!member) {
+          continue;
+        }
+
+        if (total >= RFAL_ANALOG_CONFIG_IDX_LEN) {
+          return;                                   /* Index too small, keep the linear search */
+        }
+        total++;
+
+        b = RFAL_ANALOG_CONFIG_IDX_BUCKET(id, slot);
+        if (pass == 0U) {
+          idx->start[b + 1U]++;
+        } else {
+          idx->offset[idx->start[b]] = i;           /* start[] used as write position */
+          idx->start[b]++;
+        }
+      }
+
+      i += (uint16_t)(sizeof(rfalAnalogConfigId) + sizeof(rfalAnalogConfigNum)
+                      + (tbl[i + sizeof(rfalAnalogConfigId)] * sizeof(rfalAnalogConfigRegAddrMaskVal)));
+    }
+
+    if (pass == 0U) {
+      /* Turn the counts into the position of each bucket */
+      for (b = 0U; b < RFAL_ANALOG_CONFIG_IDX_BUCKETS; b++) {
+        idx->start[b + 1U] += idx->start[b];
+      }
+    }
+  }
+
+  /* Write positions ended at the start of the next bucket, shift them back */
+  for (b = RFAL_ANALOG_CONFIG_IDX_BUCKETS; b > 0U; b--) {
+    idx->start[b] = idx->start[b - 1U];
+  }
+  idx->start[0] = 0U;
+
+  idx->valid = true;
+}
+
+#endif /* ST25R200_FEATURE_ANALOG_INDEX */
@@ -35,6 +35,10 @@
  ******************************************************************************
  */
 
+#define RFAL_ANALOG_CONFIG_TBL_HDR_LEN    3U       /*!< Configuration ID[2], Number of Register sets to follow[1] */
+#define RFAL_ANALOG_CONFIG_TBL_SET_LEN    4U       /*!< Register[2], Mask[1], Value[1]                            */
+#define RFAL_ANALOG_CONFIG_TBL_TEST_REG   0x0080U  /*!< Test Register indicator                                   */
+
 /*
  ******************************************************************************
  * GLOBAL MACROS
@@ -387,9 +391,168 @@
  * GLOBAL DATA TYPES
  ******************************************************************************
  */
-/*  PRQA S 3674 2 # CERT ARR02 - Flexible array will be used with sizeof, on adding elements error-prone manual update of size would be required */
-/*  PRQA S 3406 1 # MISRA 8.6 - Externally generated table included by the library */   /*  PRQA S 1514 1 # MISRA 8.9 - Externally generated table included by the library */
-const uint8_t rfalAnalogConfigDefaultSettings[] = {
+
+/*! Analog Configuration table produced at compile time by rfalAnalogConfigTblCompile() */
+template <uint16_t N>
+struct rfalAnalogConfigTblImage {
+  uint8_t data[N];                         /*!< Table in the Configuration ID, Number, Register-Mask-Value sets layout */
+};
+
+
+/*
+ ******************************************************************************
+ * GLOBAL FUNCTIONS
+ ******************************************************************************
+ */
+
+/*! Register address of a Register-Mask-Value set */
+constexpr uint16_t rfalAnalogConfigTblAddr(const uint8_t *set)
+{
+  return (uint16_t)(((uint16_t)set[0] << 8U) | (uint16_t)set[1]);
+}
+
+
+/*! Check that the Register-Mask-Value sets of every Configuration ID end exactly at the end of the table */
+constexpr bool rfalAnalogConfigTblIsValid(const uint8_t *src, uint16_t len)
+{
+  uint16_t i = 0U;
+
+  while ((i + RFAL_ANALOG_CONFIG_TBL_HDR_LEN) <= len) {
+    i += (uint16_t)(RFAL_ANALOG_CONFIG_TBL_HDR_LEN + (src[i + 2U] * RFAL_ANALOG_CONFIG_TBL_SET_LEN));
+  }
+  return (i == len);
+}
+
+
+/*!
+ *****************************************************************************
+ * \brief  Compile an Analog Configuration table
+ *
+ * Within each Configuration ID, the changes of a same register are merged into
+ * one set and the sets are sorted by register address, so that they come as
+ * contiguous runs ready to be written in bursts.
+ * Test register accesses keep their position: changes are only merged and
+ * sorted between them.
+ *
+ * \param[in]  src : table built with the MODE_ENTRY_n_REG macros
+ * \param[in]  len : length of src
+ * \param[out] out : compiled table, at most len bytes
+ *
+ * \return length of the compiled table
+ *****************************************************************************
+ */
+constexpr uint16_t rfalAnalogConfigTblCompileTo(const uint8_t *src, uint16_t len, uint8_t *out)
+{
+  uint16_t i   = 0U;
+  uint16_t o   = 0U;
+  uint16_t hdr = 0U;
+  uint16_t run = 0U;
+  uint16_t j   = 0U;
+  uint16_t addr = 0U;
+  uint8_t  num = 0U;
+  uint8_t  cnt = 0U;
+  uint8_t  k   = 0U;
+  uint8_t  b   = 0U;
+  bool     merged = false;
+  const uint8_t *set = nullptr;
+
+  while ((i + RFAL_ANALOG_CONFIG_TBL_HDR_LEN) <= len) {
+    num = src[i + 2U];
+    if ((i + RFAL_ANALOG_CONFIG_TBL_HDR_LEN + (num * RFAL_ANALOG_CONFIG_TBL_SET_LEN)) > len) {
+      break;
+    }
+
+    hdr        = o;
+    out[o]     = src[i];
+    out[o + 1U] = src[i + 1U];
+    o   += RFAL_ANALOG_CONFIG_TBL_HDR_LEN;
+    run  = o;
+    cnt  = 0U;
+
+    for (k = 0U; k < num; k++) {
+      set  = &src[i + RFAL_ANALOG_CONFIG_TBL_HDR_LEN + (k * RFAL_ANALOG_CONFIG_TBL_SET_LEN)];
+      addr = rfalAnalogConfigTblAddr(set);
+
+      /* Merge with a change of the same register since the last test register access */
+      merged = false;
+      if ((addr & RFAL_ANALOG_CONFIG_TBL_TEST_REG) == 0U) {
+        for (j = run; j < o; j += RFAL_ANALOG_CONFIG_TBL_SET_LEN) {
+          if (rfalAnalogConfigTblAddr(&out[j]) == addr) {
+            out[j + 3U] = (uint8_t)((out[j + 3U] & ~set[2]) | (set[3] & set[2]));
+            out[j + 2U] = (uint8_t)(out[j + 2U] | set[2]);
+            merged = true;
+            break;
+          }
+        }
+      }
+      if (merged) {
+        continue;
+      }
+
+      /* Insert keeping the run sorted by address, a test register access ends the run */
+      j = o;
+      if ((addr & RFAL_ANALOG_CONFIG_TBL_TEST_REG) == 0U) {
+        while ((j > run) && (rfalAnalogConfigTblAddr(&out[j - RFAL_ANALOG_CONFIG_TBL_SET_LEN]) > addr)) {
+          for (b = 0U; b < RFAL_ANALOG_CONFIG_TBL_SET_LEN; b++) {
+            out[j + b] = out[(j - RFAL_ANALOG_CONFIG_TBL_SET_LEN) + b];
+          }
+          j -= RFAL_ANALOG_CONFIG_TBL_SET_LEN;
+        }
+      }
+      for (b = 0U; b < RFAL_ANALOG_CONFIG_TBL_SET_LEN; b++) {
+        out[j + b] = set[b];
+      }
+      o += RFAL_ANALOG_CONFIG_TBL_SET_LEN;
+      cnt++;
+
+      if ((addr & RFAL_ANALOG_CONFIG_TBL_TEST_REG) != 0U) {
+        run = o;
+      }
+    }
+
+    out[hdr + 2U] = cnt;
+    i += (uint16_t)(RFAL_ANALOG_CONFIG_TBL_HDR_LEN + (num * RFAL_ANALOG_CONFIG_TBL_SET_LEN));
+  }
+
+  return o;
+}
+
+
+/*! Length of a table once compiled */
+template <uint16_t L>
+constexpr uint16_t rfalAnalogConfigTblCompiledLen(const uint8_t (&src)[L])
+{
+  rfalAnalogConfigTblImage<L> tmp = {};
+
+  return rfalAnalogConfigTblCompileTo(src, L, tmp.data);
+}
+
+
+/*! Compile a table into an image of its compiled length N */
+template <uint16_t N, uint16_t L>
+constexpr rfalAnalogConfigTblImage<N> rfalAnalogConfigTblCompile(const uint8_t (&src)[L])
+{
+  rfalAnalogConfigTblImage<L> tmp = {};
+  rfalAnalogConfigTblImage<N> img = {};
+  uint16_t i = 0U;
+
+  rfalAnalogConfigTblCompileTo(src, L, tmp.data);
+  for (i = 0U; i < N; i++) {
+    img.data[i] = tmp.data[i];
+  }
+  return img;
+}
+
+
+/*
+ ******************************************************************************
+ * GLOBAL VARIABLES
+ ******************************************************************************
+ */
+
+/*! Default Analog Configuration as written, only used as input of the compilation below */
+/*  PRQA S 3674 1 # CERT ARR02 - Flexible array will be used with sizeof, on adding elements error-prone manual update of size would be required */
+static constexpr uint8_t rfalAnalogConfigDefaultSource[] = {
 
   /****** Default Analog Configuration for Chip-Specific Reset ******/
   MODE_ENTRY_7_REG((RFAL_ANALOG_CONFIG_TECH_CHIP | RFAL_ANALOG_CONFIG_CHIP_INIT)
@@ -479,4 +642,14 @@ const uint8_t rfalAnalogConfigDefaultSettings[] = {
 
 };
 
+static_assert(rfalAnalogConfigTblIsValid(rfalAnalogConfigDefaultSource, sizeof(rfalAnalogConfigDefaultSource)), "Malformed default Analog Configuration table");
+
+static constexpr uint16_t rfalAnalogConfigDefaultLen = rfalAnalogConfigTblCompiledLen(rfalAnalogConfigDefaultSource);  /*!< Length of the compiled default table */
+
+static_assert(rfalAnalogConfigDefaultLen <= sizeof(rfalAnalogConfigDefaultSource), "Compiled Analog Configuration larger than its source");
+
+/*! Default Analog Configuration, registers merged and sorted per Configuration ID at compile time */
+/*  PRQA S 3406 1 # MISRA 8.6 - Externally generated table included by the library */   /*  PRQA S 1514 1 # MISRA 8.9 - Externally generated table included by the library */
+static constexpr rfalAnalogConfigTblImage<rfalAnalogConfigDefaultLen> rfalAnalogConfigDefaultSettings = rfalAnalogConfigTblCompile<rfalAnalogConfigDefaultLen>(rfalAnalogConfigDefaultSource);
+
 #endif /* ST25R200_ANALOGCONFIG_H */
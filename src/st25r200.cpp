@@ -572,10 +572,10 @@ ReturnCode RfalRfST25R200Class::st25r200SetNoResponseTime(uint32_t nrt)
     gST25R200NRT_64fcs = (64U * tmpNRT);
   }
 
-  /* Set the ST25R200 NRT step units and the value */
-  st25r200ChangeRegisterBits(ST25R200_REG_NRT_GPT_CONF, ST25R200_REG_NRT_GPT_CONF_nrt_step, nrt_step);
-  st25r200WriteRegister(ST25R200_REG_NRT1, (uint8_t)(tmpNRT >> 8U));
-  st25r200WriteRegister(ST25R200_REG_NRT2, (uint8_t)(tmpNRT & 0xFFU));
+  /* Set the ST25R200 NRT step units and the value, identical timings across frames need no bus access */
+  st25r200UpdateRegisterBits(ST25R200_REG_NRT_GPT_CONF, ST25R200_REG_NRT_GPT_CONF_nrt_step, nrt_step);
+  st25r200UpdateRegisterBits(ST25R200_REG_NRT1, 0xFFU, (uint8_t)(tmpNRT >> 8U));
+  st25r200UpdateRegisterBits(ST25R200_REG_NRT2, 0xFFU, (uint8_t)(tmpNRT & 0xFFU));
 
   return err;
 }
@@ -45,8 +45,8 @@
 */
 
 #define ST25R200_OPTIMIZE              true                           /*!< Optimization switch: false always write value to register     */
-#define ST25R200_I2C_ADDR              (0xA0U >> 1)                   /*!< ST25R200's default I2C address                                */
 #define ST25R200_REG_LEN               1U                             /*!< Byte length of a ST25R200 register                            */
+#define ST25R200_TEST_REG_HDR_LEN      2U                             /*!< Test register access header: test access command + address    */
 
 #define ST25R200_FIFO_LOAD             (0x80U)                        /*!< ST25R200 Operation Mode: FIFO Load                            */
 #define ST25R200_FIFO_READ             (0x9FU)                        /*!< ST25R200 Operation Mode: FIFO Read                            */
@@ -54,6 +54,21 @@
 
 #define ST25R200_BUF_LEN               (ST25R200_CMD_LEN+ST25R200_FIFO_DEPTH) /*!< ST25R200 communication buffer: CMD + FIFO length      */
 
+#define ST25R200_SHADOW_BIT(reg)       ((uint64_t)1U << (reg))        /*!< Bit of a register in the volatile register bitmap             */
+
+/*! Registers that may change without a write from the host and must never be served from the shadow */
+#define ST25R200_SHADOW_VOLATILE_REGS  ( ST25R200_SHADOW_BIT(ST25R200_REG_DISPLAY1)    | ST25R200_SHADOW_BIT(ST25R200_REG_DISPLAY2)     \
+                                       | ST25R200_SHADOW_BIT(ST25R200_REG_STATUS)      | ST25R200_SHADOW_BIT(ST25R200_REG_DISPLAY3)     \
+                                       | ST25R200_SHADOW_BIT(ST25R200_REG_DISPLAY4)    | ST25R200_SHADOW_BIT(ST25R200_REG_WU_I_ADC)     \
+                                       | ST25R200_SHADOW_BIT(ST25R200_REG_WU_I_REF)    | ST25R200_SHADOW_BIT(ST25R200_REG_WU_I_CAL)     \
+                                       | ST25R200_SHADOW_BIT(ST25R200_REG_WU_Q_ADC)    | ST25R200_SHADOW_BIT(ST25R200_REG_WU_Q_REF)     \
+                                       | ST25R200_SHADOW_BIT(ST25R200_REG_WU_Q_CAL)    | ST25R200_SHADOW_BIT(ST25R200_REG_FIFO_STATUS1) \
+                                       | ST25R200_SHADOW_BIT(ST25R200_REG_FIFO_STATUS2) | ST25R200_SHADOW_BIT(ST25R200_REG_COLLISION)   \
+                                       | ST25R200_SHADOW_BIT(ST25R200_REG_IRQ_MASK1)   | ST25R200_SHADOW_BIT(ST25R200_REG_IRQ_MASK2)    \
+                                       | ST25R200_SHADOW_BIT(ST25R200_REG_IRQ_MASK3)   | ST25R200_SHADOW_BIT(ST25R200_REG_IRQ1)         \
+                                       | ST25R200_SHADOW_BIT(ST25R200_REG_IRQ2)        | ST25R200_SHADOW_BIT(ST25R200_REG_IRQ3)         \
+                                       | ST25R200_SHADOW_BIT(ST25R200_REG_IC_ID) )
+
 /*
 ******************************************************************************
 * LOCAL VARIABLES
@@ -83,25 +98,29 @@ ReturnCode RfalRfST25R200Class::st25r200ReadRegister(uint8_t reg, uint8_t *val)
 /*******************************************************************************/
 ReturnCode RfalRfST25R200Class::st25r200ReadMultipleRegisters(uint8_t reg, uint8_t *values, uint16_t length)
 {
-  if (length > 0U) {
+  ReturnCode ret;
+  uint8_t    hdr;
 
-    /* Setting Transaction Parameters */
-    dev_spi->beginTransaction(SPISettings(spi_speed, MSBFIRST, SPI_MODE1));
-    digitalWrite(cs_pin, LOW);
+  ret = ERR_NONE;
+
+  if (length > 0U) {
 
-    uint8_t response = dev_spi->transfer((reg | ST25R200_READ_MODE));
-    dev_spi->transfer((void *)values, length);
+    /* The bus may still be owned by an asynchronous FIFO transfer */
+    EXIT_ON_ERR(ret, st25r200FifoXferWait());
+    st25r200SessionLock();
 
-    digitalWrite(cs_pin, HIGH);
-    dev_spi->endTransaction();
+    hdr = (reg | ST25R200_READ_MODE);
+    ret = transport->transfer(&hdr, ST25R200_CMD_LEN, NULL, values, length);
 
-    if (isr_pending) {
-      st25r200Isr();
-      isr_pending = false;
+    if (ret == ERR_NONE) {
+      st25r200ShadowUpdate(reg, values, length);
+      st25r200BatchOverlay(reg, values, length);
     }
+
+    st25r200IsrServePending();
   }
 
-  return ERR_NONE;
+  return ret;
 }
 
 
@@ -116,30 +135,46 @@ ReturnCode RfalRfST25R200Class::st25r200WriteRegister(uint8_t reg, uint8_t val)
 /*******************************************************************************/
 ReturnCode RfalRfST25R200Class::st25r200WriteMultipleRegisters(uint8_t reg, const uint8_t *values, uint16_t length)
 {
-  if (length > 0U) {
+  ReturnCode ret;
+  uint8_t    hdr;
+  uint16_t   i;
+
+  if ((values == NULL) && (length > 0U)) {
+    return ERR_PARAM;
+  }
 
-    uint8_t tx[256];
+  ret = ERR_NONE;
 
-    if (values != NULL) {
-      (void)memcpy(tx, values, length);
+#if ST25R200_FEATURE_REG_BATCH
+  /* Queue register writes while a batch is open, FIFO accesses are never queued */
+  if ((st25r200Batch.depth > 0U) && (reg <= ST25R200_REG_IC_ID)) {
+    for (i = 0; i < length; i++) {
+      EXIT_ON_ERR(ret, st25r200BatchQueue((uint8_t)(reg + i), 0xFFU, values[i]));
     }
-    /* Setting Transaction Parameters */
-    dev_spi->beginTransaction(SPISettings(spi_speed, MSBFIRST, SPI_MODE1));
-    digitalWrite(cs_pin, LOW);
+    return ERR_NONE;
+  }
+#endif /* ST25R200_FEATURE_REG_BATCH */
+
+  if (length > 0U) {
 
-    uint8_t response = dev_spi->transfer((reg | ST25R200_WRITE_MODE));
-    dev_spi->transfer((void *) tx, length);
+    /* The bus may still be owned by an asynchronous FIFO transfer */
+    EXIT_ON_ERR(ret, st25r200FifoXferWait());
+    st25r200SessionLock();
 
-    digitalWrite(cs_pin, HIGH);
-    dev_spi->endTransaction();
+    hdr = (reg | ST25R200_WRITE_MODE);
+    ret = transport->transfer(&hdr, ST25R200_CMD_LEN, values, NULL, length);
 
-    if (isr_pending) {
-      st25r200Isr();
-      isr_pending = false;
+    if (ret == ERR_NONE) {
+      st25r200ShadowUpdate(reg, values, length);
+    } else {
+      /* Content of the registers unknown after a failed write */
+      st25r200ShadowInvalidate();
     }
+
+    st25r200IsrServePending();
   }
 
-  return ERR_NONE;
+  return ret;
 }
 
 
@@ -150,9 +185,7 @@ ReturnCode RfalRfST25R200Class::st25r200WriteFifo(const uint8_t *values, uint16_
     return ERR_PARAM;
   }
 
-  st25r200WriteMultipleRegisters(ST25R200_FIFO_ACCESS, values, length);
-
-  return ERR_NONE;
+  return st25r200WriteMultipleRegisters(ST25R200_FIFO_ACCESS, values, length);
 }
 
 
@@ -164,7 +197,7 @@ ReturnCode RfalRfST25R200Class::st25r200ReadFifo(uint8_t *buf, uint16_t length)
       return ERR_PARAM;
     }
 
-    st25r200ReadMultipleRegisters(ST25R200_FIFO_ACCESS, buf, length);
+    return st25r200ReadMultipleRegisters(ST25R200_FIFO_ACCESS, buf, length);
   }
 
   return ERR_NONE;
@@ -172,111 +205,240 @@ ReturnCode RfalRfST25R200Class::st25r200ReadFifo(uint8_t *buf, uint16_t length)
 
 
 /*******************************************************************************/
-ReturnCode RfalRfST25R200Class::st25r200ExecuteCommand(uint8_t cmd)
+ReturnCode RfalRfST25R200Class::st25r200SetFifoXferHook(st25r200FifoXferHook hook, void *ctx)
 {
+#if ST25R200_FEATURE_FIFO_ASYNC
+  ReturnCode ret;
 
-  /* Setting Transaction Parameters */
-  dev_spi->beginTransaction(SPISettings(spi_speed, MSBFIRST, SPI_MODE1));
-  digitalWrite(cs_pin, LOW);
+  /* Do not swap the hook below an ongoing transfer */
+  EXIT_ON_ERR(ret, st25r200FifoXferWait());
 
-  dev_spi->transfer((cmd | ST25R200_CMD_MODE));
+  st25r200Xfer.hook = hook;
+  st25r200Xfer.ctx  = ctx;
+#else
+  NO_WARNING(hook);
+  NO_WARNING(ctx);
+#endif /* ST25R200_FEATURE_FIFO_ASYNC */
 
-  digitalWrite(cs_pin, HIGH);
-  dev_spi->endTransaction();
+  return ERR_NONE;
+}
 
-  if (isr_pending) {
-    st25r200Isr();
-    isr_pending = false;
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::st25r200WriteFifoStart(const uint8_t *values, uint16_t length)
+{
+#if ST25R200_FEATURE_FIFO_ASYNC
+  if (length > ST25R200_FIFO_DEPTH) {
+    return ERR_PARAM;
   }
 
-  return ERR_NONE;
+  /* Short transfers are not worth the hook overhead */
+  if ((st25r200Xfer.hook == NULL) || (length < ST25R200_FIFO_ASYNC_MIN_LEN)) {
+    return st25r200WriteFifo(values, length);
+  }
+
+  return st25r200FifoXferStart((ST25R200_FIFO_ACCESS | ST25R200_WRITE_MODE), values, NULL, length);
+#else
+  return st25r200WriteFifo(values, length);
+#endif /* ST25R200_FEATURE_FIFO_ASYNC */
 }
 
 
 /*******************************************************************************/
-ReturnCode RfalRfST25R200Class::st25r200ReadTestRegister(uint8_t reg, uint8_t *val)
+ReturnCode RfalRfST25R200Class::st25r200ReadFifoStart(uint8_t *buf, uint16_t length)
 {
+#if ST25R200_FEATURE_FIFO_ASYNC
+  if (length > ST25R200_FIFO_DEPTH) {
+    return ERR_PARAM;
+  }
 
-  /* Setting Transaction Parameters */
-  dev_spi->beginTransaction(SPISettings(spi_speed, MSBFIRST, SPI_MODE1));
-  digitalWrite(cs_pin, LOW);
+  /* Short transfers are not worth the hook overhead */
+  if ((st25r200Xfer.hook == NULL) || (length < ST25R200_FIFO_ASYNC_MIN_LEN)) {
+    return st25r200ReadFifo(buf, length);
+  }
 
-  dev_spi->transfer(ST25R200_CMD_TEST_ACCESS);
-  dev_spi->transfer((reg | ST25R200_READ_MODE));
+  return st25r200FifoXferStart((ST25R200_FIFO_ACCESS | ST25R200_READ_MODE), NULL, buf, length);
+#else
+  return st25r200ReadFifo(buf, length);
+#endif /* ST25R200_FEATURE_FIFO_ASYNC */
+}
 
-  dev_spi->transfer((void *)val, ST25R200_REG_LEN);
 
-  digitalWrite(cs_pin, HIGH);
-  dev_spi->endTransaction();
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::st25r200ReadFifoFrame(uint8_t *status, uint8_t *buf, uint16_t maxLen, uint16_t *rdLen)
+{
+  ReturnCode ret;
+  uint16_t   fifoBytes;
+  uint16_t   len;
+  uint8_t    hdr;
 
-  if (isr_pending) {
-    st25r200Isr();
-    isr_pending = false;
+  if ((status == NULL) || (rdLen == NULL)) {
+    return ERR_PARAM;
   }
 
-  return ERR_NONE;
+  /* The bus may still be owned by an asynchronous FIFO transfer */
+  EXIT_ON_ERR(ret, st25r200FifoXferWait());
+  st25r200SessionLock();
+
+  /* Keep the bus for both accesses */
+  transport->lock();
+
+  hdr = (ST25R200_REG_FIFO_STATUS1 | ST25R200_READ_MODE);
+  ret = transport->transfer(&hdr, ST25R200_CMD_LEN, NULL, status, ST25R200_FIFO_STATUS_LEN);
+
+  /* Read only what is available, reading beyond the FIFO content would underflow it */
+  fifoBytes  = ((((uint16_t)status[1] & ST25R200_REG_FIFO_STATUS2_fifo_b8) >> ST25R200_REG_FIFO_STATUS2_fifo_b_shift) << 8U);
+  fifoBytes |= (uint16_t)status[0];
+
+  len = MIN(fifoBytes, maxLen);
+  len = MIN(len, ST25R200_FIFO_DEPTH);
+  len = (((buf == NULL) || (ret != ERR_NONE)) ? 0U : len);
+
+  if (len > 0U) {
+    hdr = (ST25R200_FIFO_ACCESS | ST25R200_READ_MODE);
+    ret = transport->transfer(&hdr, ST25R200_CMD_LEN, NULL, buf, len);
+  }
+
+  transport->unlock();
+
+  *rdLen = ((ret == ERR_NONE) ? len : 0U);
+
+  st25r200IsrServePending();
+
+  return ret;
 }
 
 
 /*******************************************************************************/
-ReturnCode RfalRfST25R200Class::st25r200WriteTestRegister(uint8_t reg, uint8_t val)
+ST25R200Transport *RfalRfST25R200Class::st25r200GetTransport(void)
 {
+  return transport;
+}
 
-  uint8_t value = val;               /* MISRA 17.8: use intermediate variable */
-  /* Setting Transaction Parameters */
-  dev_spi->beginTransaction(SPISettings(spi_speed, MSBFIRST, SPI_MODE1));
-  digitalWrite(cs_pin, LOW);
 
-  dev_spi->transfer(ST25R200_CMD_TEST_ACCESS);
+/*******************************************************************************/
+void RfalRfST25R200Class::st25r200FifoXferDone(void)
+{
+#if ST25R200_FEATURE_FIFO_ASYNC
+  st25r200Xfer.done = true;
+#endif /* ST25R200_FEATURE_FIFO_ASYNC */
+}
 
-  dev_spi->transfer((reg | ST25R200_WRITE_MODE));
 
-  dev_spi->transfer((void *)&value, ST25R200_REG_LEN);
+/*******************************************************************************/
+bool RfalRfST25R200Class::st25r200FifoXferIsBusy(void)
+{
+#if ST25R200_FEATURE_FIFO_ASYNC
+  if (!st25r200Xfer.busy) {
+    return false;
+  }
 
-  digitalWrite(cs_pin, HIGH);
-  dev_spi->endTransaction();
+  if (!st25r200Xfer.done) {
+    if (!timerIsExpired(st25r200Xfer.tmr)) {
+      return true;
+    }
 
+    /* Completion never signalled, release the bus anyway: the FIFO content is not reliable */
+    st25r200Xfer.status = ERR_TIMEOUT;
+  }
 
-  if (isr_pending) {
-    st25r200Isr();
-    isr_pending = false;
+  /* Data phase completed, terminate the bus transaction */
+  transport->transferEnd();
+
+  st25r200Xfer.busy = false;
+
+  /* Serve the interrupt deferred while the bus was owned by the transfer */
+  st25r200IsrServePending();
+#endif /* ST25R200_FEATURE_FIFO_ASYNC */
+
+  return false;
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::st25r200ExecuteCommand(uint8_t cmd)
+{
+  ReturnCode ret;
+  uint8_t    hdr;
+
+#if ST25R200_FEATURE_REG_BATCH
+  /* Queued register changes must be in place before the command is executed */
+  if (st25r200Batch.depth > 0U) {
+    st25r200BatchFlush();
   }
+#endif /* ST25R200_FEATURE_REG_BATCH */
 
-  return ERR_NONE;
+  /* Set Default restores the reset value of all registers */
+  if (cmd == ST25R200_CMD_SET_DEFAULT) {
+    st25r200ShadowInvalidate();
+  }
+
+  /* The bus may still be owned by an asynchronous FIFO transfer */
+  EXIT_ON_ERR(ret, st25r200FifoXferWait());
+  st25r200SessionLock();
+
+  hdr = (cmd | ST25R200_CMD_MODE);
+  ret = transport->transfer(&hdr, ST25R200_CMD_LEN, NULL, NULL, 0U);
+
+  st25r200IsrServePending();
+
+  return ret;
 }
 
 
 /*******************************************************************************/
-ReturnCode RfalRfST25R200Class::st25r200WriteMultipleTestRegister(uint8_t reg, const uint8_t *values, uint8_t length)
+ReturnCode RfalRfST25R200Class::st25r200ReadTestRegister(uint8_t reg, uint8_t *val)
 {
-  if (length > 0U) {
+  ReturnCode ret;
+  uint8_t    hdr[ST25R200_TEST_REG_HDR_LEN];
 
-    uint8_t tx[256];
+  EXIT_ON_ERR(ret, st25r200FifoXferWait());
+  st25r200SessionLock();
 
-    if (values != NULL) {
-      (void)memcpy(tx, values, length);
-    }
+  hdr[0] = ST25R200_CMD_TEST_ACCESS;
+  hdr[1] = (reg | ST25R200_READ_MODE);
+  ret = transport->transfer(hdr, ST25R200_TEST_REG_HDR_LEN, NULL, val, ST25R200_REG_LEN);
 
-    /* Setting Transaction Parameters */
-    dev_spi->beginTransaction(SPISettings(spi_speed, MSBFIRST, SPI_MODE1));
-    digitalWrite(cs_pin, LOW);
+  st25r200IsrServePending();
 
-    dev_spi->transfer(ST25R200_CMD_TEST_ACCESS);
+  return ret;
+}
 
-    dev_spi->transfer((reg | ST25R200_WRITE_MODE));
 
-    dev_spi->transfer((void *)values, length);
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::st25r200WriteTestRegister(uint8_t reg, uint8_t val)
+{
+  uint8_t value = val;               /* MISRA 17.8: use intermediate variable */
+
+  return st25r200WriteMultipleTestRegister(reg, &value, ST25R200_REG_LEN);
+}
 
-    digitalWrite(cs_pin, HIGH);
-    dev_spi->endTransaction();
 
-    if (isr_pending) {
-      st25r200Isr();
-      isr_pending = false;
-    }
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::st25r200WriteMultipleTestRegister(uint8_t reg, const uint8_t *values, uint8_t length)
+{
+  ReturnCode ret;
+  uint8_t    hdr[ST25R200_TEST_REG_HDR_LEN];
+
+  if ((values == NULL) && (length > 0U)) {
+    return ERR_PARAM;
   }
 
-  return ERR_NONE;
+  ret = ERR_NONE;
+
+  if (length > 0U) {
+
+    EXIT_ON_ERR(ret, st25r200FifoXferWait());
+    st25r200SessionLock();
+
+    hdr[0] = ST25R200_CMD_TEST_ACCESS;
+    hdr[1] = (reg | ST25R200_WRITE_MODE);
+    ret = transport->transfer(hdr, ST25R200_TEST_REG_HDR_LEN, values, NULL, length);
+
+    st25r200IsrServePending();
+  }
+
+  return ret;
 }
 
 
@@ -286,8 +448,14 @@ ReturnCode RfalRfST25R200Class::st25r200ClrRegisterBits(uint8_t reg, uint8_t clr
   ReturnCode ret;
   uint8_t    rdVal;
 
+#if ST25R200_FEATURE_REG_BATCH
+  if (st25r200Batch.depth > 0U) {
+    return st25r200BatchQueue(reg, clr_mask, 0x00U);
+  }
+#endif /* ST25R200_FEATURE_REG_BATCH */
+
   /* Read current reg value */
-  EXIT_ON_ERR(ret, st25r200ReadRegister(reg, &rdVal));
+  EXIT_ON_ERR(ret, st25r200ShadowReadRegister(reg, &rdVal));
 
   /* Only perform a Write if value to be written is different */
   if (ST25R200_OPTIMIZE && (rdVal == (uint8_t)(rdVal & ~clr_mask))) {
@@ -305,8 +473,14 @@ ReturnCode RfalRfST25R200Class::st25r200SetRegisterBits(uint8_t reg, uint8_t set
   ReturnCode ret;
   uint8_t    rdVal;
 
+#if ST25R200_FEATURE_REG_BATCH
+  if (st25r200Batch.depth > 0U) {
+    return st25r200BatchQueue(reg, set_mask, set_mask);
+  }
+#endif /* ST25R200_FEATURE_REG_BATCH */
+
   /* Read current reg value */
-  EXIT_ON_ERR(ret, st25r200ReadRegister(reg, &rdVal));
+  EXIT_ON_ERR(ret, st25r200ShadowReadRegister(reg, &rdVal));
 
   /* Only perform a Write if the value to be written is different */
   if (ST25R200_OPTIMIZE && (rdVal == (rdVal | set_mask))) {
@@ -332,8 +506,14 @@ ReturnCode RfalRfST25R200Class::st25r200ModifyRegister(uint8_t reg, uint8_t clr_
   uint8_t    rdVal;
   uint8_t    wrVal;
 
+#if ST25R200_FEATURE_REG_BATCH
+  if (st25r200Batch.depth > 0U) {
+    return st25r200BatchQueue(reg, (clr_mask | set_mask), set_mask);
+  }
+#endif /* ST25R200_FEATURE_REG_BATCH */
+
   /* Read current reg value */
-  EXIT_ON_ERR(ret, st25r200ReadRegister(reg, &rdVal));
+  EXIT_ON_ERR(ret, st25r200ShadowReadRegister(reg, &rdVal));
 
   /* Compute new value */
   wrVal  = (uint8_t)(rdVal & ~clr_mask);
@@ -356,6 +536,13 @@ ReturnCode RfalRfST25R200Class::st25r200ChangeTestRegisterBits(uint8_t reg, uint
   uint8_t    rdVal;
   uint8_t    wrVal;
 
+#if ST25R200_FEATURE_REG_BATCH
+  /* Keep the order with respect to the register changes queued so far */
+  if (st25r200Batch.depth > 0U) {
+    EXIT_ON_ERR(ret, st25r200BatchFlush());
+  }
+#endif /* ST25R200_FEATURE_REG_BATCH */
+
   /* Read current reg value */
   EXIT_ON_ERR(ret, st25r200ReadTestRegister(reg, &rdVal));
 
@@ -393,3 +580,421 @@ bool RfalRfST25R200Class::st25r200IsRegValid(uint8_t reg)
   }
   return true;
 }
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::st25r200ShadowInvalidate(void)
+{
+  ST_MEMSET(st25r200Shadow.known, 0x00, sizeof(st25r200Shadow.known));
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::st25r200BatchBegin(void)
+{
+#if ST25R200_FEATURE_REG_BATCH
+  st25r200Batch.depth++;
+#endif /* ST25R200_FEATURE_REG_BATCH */
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::st25r200BatchQueue(uint8_t reg, uint8_t valueMask, uint8_t value)
+{
+#if ST25R200_FEATURE_REG_BATCH
+  ReturnCode ret;
+  uint8_t    i;
+
+  if (st25r200Batch.depth == 0U) {
+    return st25r200ChangeRegisterBits(reg, valueMask, value);
+  }
+
+  if (reg > ST25R200_REG_IC_ID) {
+    return ERR_PARAM;
+  }
+
+  if (valueMask == 0U) {
+    return ERR_NONE;
+  }
+
+  /* Merge with a change already queued for the same register */
+  for (i = 0; i < st25r200Batch.cnt; i++) {
+    if (st25r200Batch.entry[i].reg == reg) {
+      st25r200Batch.entry[i].val   = (uint8_t)((st25r200Batch.entry[i].val & ~valueMask) | (value & valueMask));
+      st25r200Batch.entry[i].mask |= valueMask;
+      return ERR_NONE;
+    }
+  }
+
+  /* No room left, write out what has been queued so far */
+  if (st25r200Batch.cnt >= ST25R200_REG_BATCH_LEN) {
+    EXIT_ON_ERR(ret, st25r200BatchFlush());
+  }
+
+  st25r200Batch.entry[st25r200Batch.cnt].reg  = reg;
+  st25r200Batch.entry[st25r200Batch.cnt].mask = valueMask;
+  st25r200Batch.entry[st25r200Batch.cnt].val  = (uint8_t)(value & valueMask);
+  st25r200Batch.cnt++;
+
+  return ERR_NONE;
+#else
+  return st25r200ChangeRegisterBits(reg, valueMask, value);
+#endif /* ST25R200_FEATURE_REG_BATCH */
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::st25r200BatchCommit(void)
+{
+#if ST25R200_FEATURE_REG_BATCH
+  if (st25r200Batch.depth == 0U) {
+    return ERR_WRONG_STATE;
+  }
+
+  st25r200Batch.depth--;
+
+  /* Only the outermost commit writes the queued changes */
+  if (st25r200Batch.depth == 0U) {
+    return st25r200BatchFlush();
+  }
+#endif /* ST25R200_FEATURE_REG_BATCH */
+
+  return ERR_NONE;
+}
+
+
+/*
+******************************************************************************
+* LOCAL FUNCTIONS
+******************************************************************************
+*/
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::st25r200ShadowReadRegister(uint8_t reg, uint8_t *val)
+{
+#if ST25R200_FEATURE_SHADOW_REGS
+  /* Serve the read half of a read-modify-write from the shadow when possible */
+  if ((reg <= ST25R200_REG_IC_ID) && (st25r200Shadow.known[reg] == 0xFFU)) {
+    *val = st25r200Shadow.val[reg];
+    return ERR_NONE;
+  }
+#endif /* ST25R200_FEATURE_SHADOW_REGS */
+
+  return st25r200ReadRegister(reg, val);
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::st25r200ShadowUpdate(uint8_t reg, const uint8_t *values, uint16_t length)
+{
+  uint16_t i;
+  uint16_t addr;
+
+  if (values == NULL) {
+    return;
+  }
+
+  /* Registers are accessed with auto-increment, FIFO accesses are out of range */
+  for (i = 0; i < length; i++) {
+    addr = ((uint16_t)reg + i);
+    if (addr > ST25R200_REG_IC_ID) {
+      break;
+    }
+
+    if ((ST25R200_SHADOW_VOLATILE_REGS & ST25R200_SHADOW_BIT(addr)) == 0U) {
+      st25r200Shadow.val[addr]   = values[i];
+      st25r200Shadow.known[addr] = 0xFFU;
+    }
+  }
+}
+
+
+/*******************************************************************************/
+bool RfalRfST25R200Class::st25r200ShadowHolds(uint8_t reg, uint8_t mask, uint8_t val)
+{
+  uint8_t cur;
+  uint8_t known;
+#if ST25R200_FEATURE_REG_BATCH
+  uint8_t i;
+#endif /* ST25R200_FEATURE_REG_BATCH */
+
+  if (reg > ST25R200_REG_IC_ID) {
+    return false;
+  }
+
+  cur   = st25r200Shadow.val[reg];
+  known = st25r200Shadow.known[reg];
+
+#if ST25R200_FEATURE_REG_BATCH
+  /* A change still queued is what the register is going to hold */
+  for (i = 0; i < st25r200Batch.cnt; i++) {
+    if (st25r200Batch.entry[i].reg == reg) {
+      cur    = (uint8_t)((cur & ~st25r200Batch.entry[i].mask) | st25r200Batch.entry[i].val);
+      known |= st25r200Batch.entry[i].mask;
+    }
+  }
+#endif /* ST25R200_FEATURE_REG_BATCH */
+
+  return (((known & mask) == mask) && (((cur ^ val) & mask) == 0U));
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::st25r200UpdateRegisterBits(uint8_t reg, uint8_t valueMask, uint8_t value)
+{
+  /* Bits known to hold the value already need no bus access at all */
+  if (st25r200ShadowHolds(reg, valueMask, value)) {
+    return ERR_NONE;
+  }
+
+  return st25r200ChangeRegisterBits(reg, valueMask, value);
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::st25r200BatchFlush(void)
+{
+#if ST25R200_FEATURE_REG_BATCH
+  st25r200RegBatchEntry tmp;
+  st25r200RegBatchEntry *entry;
+  uint8_t               rdVal[ST25R200_REG_BATCH_LEN];
+  uint8_t               wrVal[ST25R200_REG_BATCH_LEN];
+  bool                  known[ST25R200_REG_BATCH_LEN];
+  bool                  needRead;
+  uint8_t               kept;
+  ReturnCode            ret;
+  uint8_t               depth;
+  uint8_t               i;
+  uint8_t               j;
+  uint8_t               len;
+  uint8_t               first;
+  uint8_t               last;
+
+  ret   = ERR_NONE;
+  entry = st25r200Batch.entry;
+
+  /* Close the batch temporarily so that the accesses below go to the chip */
+  depth = st25r200Batch.depth;
+  st25r200Batch.depth = 0U;
+
+  /* Sort the queued changes by register address */
+  for (i = 1U; i < st25r200Batch.cnt; i++) {
+    tmp = entry[i];
+    for (j = i; (j > 0U) && (entry[j - 1U].reg > tmp.reg); j--) {
+      entry[j] = entry[j - 1U];
+    }
+    entry[j] = tmp;
+  }
+
+  i = 0U;
+  while ((i < st25r200Batch.cnt) && (ret == ERR_NONE)) {
+    /* Find the run of contiguous register addresses starting at entry i */
+    len = 1U;
+    while (((i + len) < st25r200Batch.cnt) && (entry[i + len].reg == (entry[i + len - 1U].reg + 1U))) {
+      len++;
+    }
+
+    /* Retrieve the current content if any register of the run is only partially changed */
+    needRead = false;
+    for (j = 0U; j < len; j++) {
+      kept     = 0x00U;
+      rdVal[j] = 0x00U;
+#if ST25R200_FEATURE_SHADOW_REGS
+      kept     = st25r200Shadow.known[entry[i + j].reg];
+      rdVal[j] = st25r200Shadow.val[entry[i + j].reg];
+#endif /* ST25R200_FEATURE_SHADOW_REGS */
+      known[j] = (kept == 0xFFU);
+      if ((uint8_t)(kept | entry[i + j].mask) != 0xFFU) {
+        needRead = true;
+      }
+    }
+
+    if (needRead) {
+      ret = st25r200ReadMultipleRegisters(entry[i].reg, rdVal, len);
+      for (j = 0U; j < len; j++) {
+        known[j] = true;
+      }
+    }
+
+    /* Compute new values and the span that actually changes */
+    first = len;
+    last  = 0U;
+    for (j = 0U; j < len; j++) {
+      wrVal[j] = (uint8_t)((rdVal[j] & ~entry[i + j].mask) | entry[i + j].val);
+
+      if ((!ST25R200_OPTIMIZE) || (!known[j]) || (wrVal[j] != rdVal[j])) {
+        first = ((first == len) ? j : first);
+        last  = j;
+      }
+    }
+
+    /* Write the changed span with a single burst */
+    if ((ret == ERR_NONE) && (first < len)) {
+      ret = st25r200WriteMultipleRegisters((uint8_t)(entry[i].reg + first), &wrVal[first], (uint16_t)((last - first) + 1U));
+    }
+
+    i += len;
+  }
+
+  st25r200Batch.cnt   = 0U;
+  st25r200Batch.depth = depth;
+
+  return ret;
+#else
+  return ERR_NONE;
+#endif /* ST25R200_FEATURE_REG_BATCH */
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::st25r200BatchOverlay(uint8_t reg, uint8_t *values, uint16_t length)
+{
+#if ST25R200_FEATURE_REG_BATCH
+  uint8_t  i;
+  uint16_t idx;
+
+  if ((st25r200Batch.depth == 0U) || (values == NULL)) {
+    return;
+  }
+
+  /* Reflect the changes still queued on the values read from the chip */
+  for (i = 0; i < st25r200Batch.cnt; i++) {
+    if (st25r200Batch.entry[i].reg >= reg) {
+      idx = (uint16_t)(st25r200Batch.entry[i].reg - reg);
+      if (idx < length) {
+        values[idx] = (uint8_t)((values[idx] & ~st25r200Batch.entry[i].mask) | st25r200Batch.entry[i].val);
+      }
+    }
+  }
+#else
+  NO_WARNING(reg);
+  NO_WARNING(values);
+  NO_WARNING(length);
+#endif /* ST25R200_FEATURE_REG_BATCH */
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::st25r200FifoXferStart(uint8_t header, const uint8_t *txData, uint8_t *rxData, uint16_t length)
+{
+#if ST25R200_FEATURE_FIFO_ASYNC
+  ReturnCode ret;
+  uint8_t    hdr;
+
+  EXIT_ON_ERR(ret, st25r200FifoXferWait());
+  st25r200SessionLock();
+
+  hdr = header;
+
+  /* Own the bus before the transaction starts, an IRQ meanwhile is deferred by st25r200Isr() */
+  st25r200Xfer.done = false;
+  st25r200Xfer.busy = true;
+
+  /* Transports not able to keep a transaction open perform the transfer blocking */
+  if (!transport->transferStart(&hdr, ST25R200_CMD_LEN)) {
+    ret = transport->transfer(&hdr, ST25R200_CMD_LEN, txData, rxData, length);
+
+    st25r200Xfer.busy = false;
+    st25r200IsrServePending();
+    return ret;
+  }
+
+  /* Hand the data phase over to the hook, the transaction is closed once it signals completion */
+  st25r200Xfer.tmr = timerCalculateTimerUs(ST25R200_FIFO_XFER_TOUT_US);
+  if (st25r200Xfer.hook(st25r200Xfer.ctx, txData, rxData, length) == ERR_NONE) {
+    transport->account(((txData != NULL) ? length : 0U), ((txData != NULL) ? 0U : length));
+  } else {
+    /* Hook not able to take over, perform the data phase here */
+    transport->transferData(txData, rxData, length);
+    st25r200Xfer.done = true;
+  }
+#else
+  NO_WARNING(header);
+  NO_WARNING(txData);
+  NO_WARNING(rxData);
+  NO_WARNING(length);
+#endif /* ST25R200_FEATURE_FIFO_ASYNC */
+
+  return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::st25r200FifoXferWait(void)
+{
+#if ST25R200_FEATURE_FIFO_ASYNC
+  ReturnCode ret;
+
+  while (st25r200FifoXferIsBusy()) {
+    /* Wait for the transfer hook to signal completion, bounded by the transfer timer */
+  }
+
+  /* Report an aborted transfer once */
+  ret = st25r200Xfer.status;
+  st25r200Xfer.status = ERR_NONE;
+
+  return ret;
+#else
+  return ERR_NONE;
+#endif /* ST25R200_FEATURE_FIFO_ASYNC */
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::st25r200SessionBegin(void)
+{
+#if ST25R200_FEATURE_BUS_SESSION
+  /* The bus is locked by the first access, see st25r200SessionLock() */
+  st25r200SessionDepth++;
+#endif /* ST25R200_FEATURE_BUS_SESSION */
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::st25r200SessionEnd(void)
+{
+#if ST25R200_FEATURE_BUS_SESSION
+  if (st25r200SessionDepth == 0U) {
+    return;
+  }
+
+  if ((st25r200SessionDepth == 1U) && st25r200SessionLocked) {
+    transport->unlock();
+    st25r200SessionLocked = false;
+  }
+
+  st25r200SessionDepth--;
+
+  st25r200IsrServePending();
+#endif /* ST25R200_FEATURE_BUS_SESSION */
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::st25r200SessionLock(void)
+{
+#if ST25R200_FEATURE_BUS_SESSION
+  /* Lock and configure the bus only once for the outermost session, sessions without access leave it alone */
+  if ((st25r200SessionDepth > 0U) && (!st25r200SessionLocked)) {
+    transport->lock();
+    st25r200SessionLocked = true;
+  }
+#endif /* ST25R200_FEATURE_BUS_SESSION */
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::st25r200IsrServePending(void)
+{
+#if ST25R200_FEATURE_BUS_SESSION
+  /* Interrupts raised during a session are served once, when it closes */
+  if (st25r200SessionDepth > 0U) {
+    return;
+  }
+#endif /* ST25R200_FEATURE_BUS_SESSION */
+
+  if (isr_pending) {
+    isr_pending = false;
+    st25r200Isr();
+  }
+}
@@ -73,6 +73,9 @@
 */
 
 #define ST25R200_FIFO_STATUS_LEN                           2        /*!< Number of FIFO Status Register                                    */
+#define ST25R200_REG_BATCH_LEN                             32U      /*!< Max number of distinct registers queued in a register batch       */
+#define ST25R200_FIFO_ASYNC_MIN_LEN                        8U       /*!< Min FIFO transfer length handed to the asynchronous transfer hook */
+#define ST25R200_FIFO_XFER_TOUT_US                         10000U   /*!< Max duration of an asynchronous FIFO transfer before it is aborted */
 
 #define ST25R200_REG_OPERATION                             0x00U    /*!< RW Operation Register                                             */
 #define ST25R200_REG_GENERAL                               0x01U    /*!< RW General Register                                               */
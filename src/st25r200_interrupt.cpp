@@ -62,6 +62,19 @@
 ******************************************************************************
 */
 
+RfalRfST25R200Class *volatile RfalRfST25R200Class::st25r200IsrInstance[ST25R200_IRQ_DISPATCH_SLOTS];
+int RfalRfST25R200Class::st25r200IsrPin[ST25R200_IRQ_DISPATCH_SLOTS];
+
+const ST25R200IrqHandler RfalRfST25R200Class::st25r200IsrDispatchTbl[ST25R200_IRQ_DISPATCH_SLOTS] = {
+  &RfalRfST25R200Class::st25r200IsrDispatch<0U>,
+  &RfalRfST25R200Class::st25r200IsrDispatch<1U>,
+  &RfalRfST25R200Class::st25r200IsrDispatch<2U>,
+  &RfalRfST25R200Class::st25r200IsrDispatch<3U>
+};
+
+/* An attached slot without entry point would jump to NULL on its first interrupt */
+static_assert(ST25R200_IRQ_DISPATCH_SLOTS == 4U, "st25r200IsrDispatchTbl needs one entry per dispatch slot");
+
 
 /*
 ******************************************************************************
@@ -78,8 +91,114 @@ void RfalRfST25R200Class::st25r200InitInterrupts(void)
 }
 
 
+/*******************************************************************************/
+ReturnCode RfalRfST25R200Class::st25r200IsrAttach(void)
+{
+  uint8_t              i;
+  uint8_t              slot;
+  RfalRfST25R200Class *prev;
+
+  /* Use the slot already bound to this instance or to its interrupt pin, else a free one */
+  slot = ST25R200_IRQ_DISPATCH_SLOTS;
+  for (i = 0; i < ST25R200_IRQ_DISPATCH_SLOTS; i++) {
+    if ((st25r200IsrInstance[i] == this) || ((st25r200IsrInstance[i] != NULL) && (st25r200IsrPin[i] == int_pin))) {
+      slot = i;
+      break;
+    }
+    if ((st25r200IsrInstance[i] == NULL) && (slot == ST25R200_IRQ_DISPATCH_SLOTS)) {
+      slot = i;
+    }
+  }
+
+  if (slot == ST25R200_IRQ_DISPATCH_SLOTS) {
+    return ERR_NOMEM;
+  }
+
+  /* An interrupt pin serves a single instance, the latest one attached */
+  prev = st25r200IsrInstance[slot];
+  if ((prev != NULL) && (prev != this)) {
+    prev->irq_slot    = ST25R200_IRQ_DISPATCH_SLOTS;
+    prev->irq_handler = NULL;
+  }
+
+  st25r200IsrPin[slot]      = int_pin;
+  st25r200IsrInstance[slot] = this;
+
+  irq_slot    = slot;
+  irq_handler = st25r200IsrDispatchTbl[slot];
+  attachInterrupt(int_pin, irq_handler, RISING);
+
+  return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::st25r200IsrDetach(void)
+{
+  if (irq_slot >= ST25R200_IRQ_DISPATCH_SLOTS) {
+    return;
+  }
+
+  detachInterrupt(int_pin);
+
+  st25r200IsrInstance[irq_slot] = NULL;
+  irq_slot    = ST25R200_IRQ_DISPATCH_SLOTS;
+  irq_handler = NULL;
+}
+
+
 /*******************************************************************************/
 void RfalRfST25R200Class::st25r200Isr(void)
+{
+#if ST25R200_FEATURE_DEFERRED_IRQ
+  uint8_t head;
+
+  /* Only record the event, the chip is accessed from worker context */
+  head = st25r200IrqEvts.head;
+  if ((uint8_t)(head - st25r200IrqEvts.tail) >= ST25R200_IRQ_EVT_RING_LEN) {
+    st25r200IrqEvts.dropped++;
+    return;
+  }
+
+  st25r200IrqEvts.evt[head & (ST25R200_IRQ_EVT_RING_LEN - 1U)].timestamp = timerGetTimeUs();
+  st25r200IrqEvts.head = (uint8_t)(head + 1U);
+
+  /* Let the upper layer schedule rfalWorker() */
+  if (NULL != st25r200interrupt.callback) {
+    st25r200interrupt.callback();
+  }
+#else
+#if ST25R200_FEATURE_ADAPTIVE_FWT
+  /* Serving may be postponed, keep the time the line was asserted for the response time learning */
+  if (!gRfalAfwt.irqTsValid) {
+    gRfalAfwt.irqTs      = timerGetTimeUs();
+    gRfalAfwt.irqTsValid = true;
+  }
+#endif /* ST25R200_FEATURE_ADAPTIVE_FWT */
+
+#if ST25R200_FEATURE_FIFO_ASYNC
+  /* The bus is owned by an asynchronous FIFO transfer, serve the interrupt once it completes */
+  if (st25r200Xfer.busy) {
+    isr_pending = true;
+    return;
+  }
+#endif /* ST25R200_FEATURE_FIFO_ASYNC */
+
+#if ST25R200_FEATURE_BUS_SESSION
+  /* The bus is held by a session, serve the interrupt once it closes */
+  if (st25r200SessionDepth > 0U) {
+    isr_pending = true;
+    return;
+  }
+#endif /* ST25R200_FEATURE_BUS_SESSION */
+
+  st25r200IsrHandle();
+#endif /* ST25R200_FEATURE_DEFERRED_IRQ */
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::st25r200IsrHandle(void)
 {
   st25r200CheckForReceivedInterrupts();
 
@@ -90,11 +209,85 @@ void RfalRfST25R200Class::st25r200Isr(void)
 }
 
 
+/*******************************************************************************/
+void RfalRfST25R200Class::st25r200IrqEvtProcess(void)
+{
+#if ST25R200_FEATURE_DEFERRED_IRQ
+  st25r200IrqEvt evt;
+  bool           pending;
+
+  /* The bus is owned by an asynchronous FIFO transfer, retry on next call */
+  if (st25r200FifoXferIsBusy()) {
+    return;
+  }
+
+  /* Several events are served by a single readout, which runs until the IRQ line is released */
+  pending = false;
+  while (st25r200IrqEvtPop(&evt)) {
+    st25r200IrqEvts.lastTimestamp = evt.timestamp;
+    pending = true;
+  }
+
+  /* The upper layer has been called back by st25r200Isr() when the event was queued */
+  if (pending) {
+    st25r200CheckForReceivedInterrupts();
+  }
+#endif /* ST25R200_FEATURE_DEFERRED_IRQ */
+}
+
+
+/*******************************************************************************/
+bool RfalRfST25R200Class::st25r200IrqEvtPop(st25r200IrqEvt *evt)
+{
+#if ST25R200_FEATURE_DEFERRED_IRQ
+  uint8_t tail;
+
+  tail = st25r200IrqEvts.tail;
+  if (tail == st25r200IrqEvts.head) {
+    return false;
+  }
+
+  *evt = st25r200IrqEvts.evt[tail & (ST25R200_IRQ_EVT_RING_LEN - 1U)];
+  st25r200IrqEvts.tail = (uint8_t)(tail + 1U);
+
+  return true;
+#else
+  NO_WARNING(evt);
+  return false;
+#endif /* ST25R200_FEATURE_DEFERRED_IRQ */
+}
+
+
+/*******************************************************************************/
+uint32_t RfalRfST25R200Class::st25r200IrqEvtGetLastTimestamp(void)
+{
+#if ST25R200_FEATURE_DEFERRED_IRQ
+  return st25r200IrqEvts.lastTimestamp;
+#else
+  return 0U;
+#endif /* ST25R200_FEATURE_DEFERRED_IRQ */
+}
+
+
+/*******************************************************************************/
+uint32_t RfalRfST25R200Class::st25r200IrqEvtGetDropped(void)
+{
+#if ST25R200_FEATURE_DEFERRED_IRQ
+  return st25r200IrqEvts.dropped;
+#else
+  return 0U;
+#endif /* ST25R200_FEATURE_DEFERRED_IRQ */
+}
+
+
 /*******************************************************************************/
 void RfalRfST25R200Class::st25r200CheckForReceivedInterrupts(void)
 {
   uint8_t  iregs[ST25R200_INT_REGS_LEN];
   uint32_t irqStatus;
+#if ST25R200_FEATURE_ADAPTIVE_FWT && !ST25R200_FEATURE_DEFERRED_IRQ
+  uint32_t irqTs;
+#endif /* ST25R200_FEATURE_ADAPTIVE_FWT && !ST25R200_FEATURE_DEFERRED_IRQ */
 
 #ifdef ST25R_POLL_IRQ
   /* Exit immediately in case of no IRQ */
@@ -107,6 +300,12 @@ void RfalRfST25R200Class::st25r200CheckForReceivedInterrupts(void)
   irqStatus = ST25R200_IRQ_MASK_NONE;
   ST_MEMSET(iregs, (int32_t)(ST25R200_IRQ_MASK_ALL & 0xFFU), ST25R200_INT_REGS_LEN);
 
+#if ST25R200_FEATURE_ADAPTIVE_FWT && !ST25R200_FEATURE_DEFERRED_IRQ
+  /* Take the time stamped by st25r200Isr() before reading, a later edge stamps the next serve */
+  irqTs = (gRfalAfwt.irqTsValid ? gRfalAfwt.irqTs : timerGetTimeUs());
+  gRfalAfwt.irqTsValid = false;
+#endif /* ST25R200_FEATURE_ADAPTIVE_FWT && !ST25R200_FEATURE_DEFERRED_IRQ */
+
   /* In case the IRQ is Edge (not Level) triggered read IRQs until done */
   while (digitalRead(int_pin) == HIGH) {
     st25r200ReadMultipleRegisters(ST25R200_REG_IRQ1, iregs, ST25R200_INT_REGS_LEN);
@@ -119,6 +318,26 @@ void RfalRfST25R200Class::st25r200CheckForReceivedInterrupts(void)
   /* Forward all interrupts, even masked ones to application */
   st25r200interrupt.status |= irqStatus;
 
+#if ST25R200_FEATURE_ADAPTIVE_FWT
+  /* Timestamp TXE and RXS for the response time learning */
+#if ST25R200_FEATURE_DEFERRED_IRQ
+  rfalAdaptiveFwtIrq(irqStatus, st25r200IrqEvts.lastTimestamp);
+#else
+  rfalAdaptiveFwtIrq(irqStatus, irqTs);
+#endif /* ST25R200_FEATURE_DEFERRED_IRQ */
+#endif /* ST25R200_FEATURE_ADAPTIVE_FWT */
+
+#if ST25R200_FEATURE_PROFILER
+  /* Retrieval latency is measured from here, or from the IRQ line assertion in deferred mode */
+  if (irqStatus != ST25R200_IRQ_MASK_NONE) {
+#if ST25R200_FEATURE_DEFERRED_IRQ
+    gRfalProf.irqTs = st25r200IrqEvts.lastTimestamp;
+#else
+    gRfalProf.irqTs = timerGetTimeUs();
+#endif /* ST25R200_FEATURE_DEFERRED_IRQ */
+  }
+#endif /* ST25R200_FEATURE_PROFILER */
+
   /* Send an IRQ event to LED handling */
   // st25r200ledEvtIrq( st25r200interrupt.status );
 }
@@ -149,11 +368,18 @@ void RfalRfST25R200Class::st25r200ModifyInterrupts(uint32_t clr_mask, uint32_t s
 
 /*******************************************************************************/
 uint32_t RfalRfST25R200Class::st25r200WaitForInterruptsTimed(uint32_t mask, uint16_t tmo)
+{
+  return st25r200WaitForInterruptsTimedUs(mask, ((uint32_t)tmo * 1000U));
+}
+
+
+/*******************************************************************************/
+uint32_t RfalRfST25R200Class::st25r200WaitForInterruptsTimedUs(uint32_t mask, uint32_t tmo)
 {
   uint32_t tmrDelay;
   uint32_t status;
 
-  tmrDelay = timerCalculateTimer(tmo);
+  tmrDelay = timerCalculateTimerUs(tmo);
 
   /* Run until specific interrupt has happen or the timer has expired */
   do {
@@ -161,6 +387,15 @@ uint32_t RfalRfST25R200Class::st25r200WaitForInterruptsTimed(uint32_t mask, uint
     st25r200CheckForReceivedInterrupts();
 #endif /* ST25R_POLL_IRQ */
 
+    /* Waiting within a bus session: serve the deferred interrupt here */
+    if (isr_pending && !st25r200FifoXferIsBusy()) {
+      isr_pending = false;
+      st25r200IsrHandle();
+    }
+
+    /* Retrieve the interrupts signalled to the deferred IRQ handler */
+    st25r200IrqEvtProcess();
+
     status = (st25r200interrupt.status & mask);
   } while (((!timerIsExpired(tmrDelay)) || (tmo == 0U)) && (status == 0U));
 
@@ -182,6 +417,9 @@ uint32_t RfalRfST25R200Class::st25r200GetInterrupt(uint32_t mask)
   irqs = (st25r200interrupt.status & mask);
   if (irqs != ST25R200_IRQ_MASK_NONE) {
     st25r200interrupt.status &= ~irqs;
+#if ST25R200_FEATURE_PROFILER
+    rfalProfSample(&gRfalProf.irq, (timerGetTimeUs() - gRfalProf.irqTs));
+#endif /* ST25R200_FEATURE_PROFILER */
   }
 
   return irqs;
@@ -92,6 +92,8 @@
 #define ST25R200_IRQ_MASK_WUT             (uint32_t)(0x00020000U)   /*!< ST25R200 wake-up interrupt                                 */
 #define ST25R200_IRQ_MASK_OSC             (uint32_t)(0x00010000U)   /*!< ST25R200 oscillator stable interrupt                       */
 
+#define ST25R200_IRQ_EVT_RING_LEN         8U                        /*!< Number of IRQ events buffered in deferred mode (power of 2) */
+
 
 /*! Holds current and previous interrupt callback pointer as well as current Interrupt status and mask */
 typedef struct {
@@ -101,6 +103,22 @@ typedef struct {
   uint32_t  mask;                  /*!< Interrupt mask. Negative mask = ST25R200 mask regs */
 } st25r200Interrupt;
 
+
+/*! IRQ line assertion captured by the hardware handler in deferred interrupt mode */
+typedef struct {
+  uint32_t  timestamp;             /*!< timerGetTimeUs() when the IRQ line was asserted     */
+} st25r200IrqEvt;
+
+
+/*! Single-producer (hardware handler) / single-consumer (worker) ring of IRQ events */
+typedef struct {
+  st25r200IrqEvt   evt[ST25R200_IRQ_EVT_RING_LEN]; /*!< Event storage                      */
+  volatile uint8_t head;           /*!< Next slot written, owned by the producer            */
+  volatile uint8_t tail;           /*!< Next slot read, owned by the consumer               */
+  volatile uint32_t dropped;       /*!< Events dropped on a full ring                       */
+  uint32_t  lastTimestamp;         /*!< Timestamp of the last event consumed                */
+} st25r200IrqRing;
+
 /*
 ******************************************************************************
 * GLOBAL FUNCTION PROTOTYPES
@@ -26,8 +26,8 @@
  *  \brief SW Timer implementation
  *
  *
- *   This module makes use of a System Tick in millisconds and provides
- *   an abstraction for SW timers
+ *   This module makes use of a microsecond time source (micros() unless
+ *   another one is set) and provides an abstraction for SW timers
  *
  */
 
@@ -61,7 +61,32 @@
 /*******************************************************************************/
 uint32_t RfalRfST25R200Class::timerCalculateTimer(uint16_t time)
 {
-  return (millis() + time);
+  return timerCalculateTimerUs((uint32_t)time * 1000U);
+}
+
+
+/*******************************************************************************/
+uint32_t RfalRfST25R200Class::timerCalculateTimerUs(uint32_t time)
+{
+  return (timerGetTimeUs() + time);
+}
+
+
+/*******************************************************************************/
+void RfalRfST25R200Class::timerSetTimeSource(st25r200TimeSource src)
+{
+  timerSource = src;
+}
+
+
+/*******************************************************************************/
+uint32_t RfalRfST25R200Class::timerGetTimeUs(void)
+{
+  if (timerSource != NULL) {
+    return timerSource();
+  }
+
+  return (uint32_t)micros();
 }
 
 
@@ -71,10 +96,10 @@ bool RfalRfST25R200Class::timerIsExpired(uint32_t timer)
   uint32_t uDiff;
   int32_t sDiff;
 
-  uDiff = (timer - millis());   /* Calculate the diff between the timers */
+  uDiff = (timer - timerGetTimeUs());   /* Calculate the diff between the timers */
   sDiff = uDiff;                            /* Convert the diff to a signed var      */
   /* Having done this has two side effects:
-   * 1) all differences smaller than -(2^31) ms (~25d) will become positive
+   * 1) all differences smaller than -(2^31) us (~35min) will become positive
    *    Signaling not expired: acceptable!
    * 2) Time roll-over case will be handled correctly: super!
    */
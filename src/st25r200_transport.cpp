@@ -0,0 +1,353 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Implementation of the ST25R200 transport interface and mock backend.
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "st25r200_transport.h"
+#include "nfc_utils.h"
+
+/*
+******************************************************************************
+* ST25R200Transport
+******************************************************************************
+*/
+
+/*******************************************************************************/
+ST25R200Transport::ST25R200Transport(void)
+{
+  resetStats();
+}
+
+
+/*******************************************************************************/
+ReturnCode ST25R200Transport::transfer(const uint8_t *hdr, uint8_t hdrLen, const uint8_t *txData, uint8_t *rxData, uint16_t length)
+{
+  stats.transactions++;
+  stats.bytesTx += hdrLen;
+  stats.lastTx   = hdrLen;
+  stats.lastRx   = 0U;
+  account(((txData != NULL) ? length : 0U), ((txData != NULL) ? 0U : length));
+
+  return xfer(hdr, hdrLen, txData, rxData, length);
+}
+
+
+/*******************************************************************************/
+bool ST25R200Transport::transferStart(const uint8_t *hdr, uint8_t hdrLen)
+{
+  if (!xferStart(hdr, hdrLen)) {
+    return false;
+  }
+
+  stats.transactions++;
+  stats.bytesTx += hdrLen;
+  stats.lastTx   = hdrLen;
+  stats.lastRx   = 0U;
+
+  return true;
+}
+
+
+/*******************************************************************************/
+ReturnCode ST25R200Transport::transferData(const uint8_t *txData, uint8_t *rxData, uint16_t length)
+{
+  account(((txData != NULL) ? length : 0U), ((txData != NULL) ? 0U : length));
+
+  return xferData(txData, rxData, length);
+}
+
+
+/*******************************************************************************/
+void ST25R200Transport::transferEnd(void)
+{
+  xferEnd();
+}
+
+
+/*******************************************************************************/
+void ST25R200Transport::account(uint16_t txBytes, uint16_t rxBytes)
+{
+  stats.bytesTx += txBytes;
+  stats.bytesRx += rxBytes;
+  stats.lastTx  += txBytes;
+  stats.lastRx  += rxBytes;
+}
+
+
+/*******************************************************************************/
+void ST25R200Transport::getStats(st25r200TransportStats *st) const
+{
+  if (st != NULL) {
+    *st = stats;
+  }
+}
+
+
+/*******************************************************************************/
+void ST25R200Transport::resetStats(void)
+{
+  ST_MEMSET(&stats, 0x00, sizeof(st25r200TransportStats));
+}
+
+
+/*******************************************************************************/
+ReturnCode ST25R200Transport::xfer(const uint8_t *hdr, uint8_t hdrLen, const uint8_t *txData, uint8_t *rxData, uint16_t length)
+{
+  ReturnCode ret;
+
+  if (!xferStart(hdr, hdrLen)) {
+    return ERR_NOTSUPP;
+  }
+
+  ret = ERR_NONE;
+  if (length > 0U) {
+    ret = xferData(txData, rxData, length);
+  }
+
+  xferEnd();
+
+  return ret;
+}
+
+
+/*******************************************************************************/
+bool ST25R200Transport::xferStart(const uint8_t *hdr, uint8_t hdrLen)
+{
+  NO_WARNING(hdr);
+  NO_WARNING(hdrLen);
+
+  return false;
+}
+
+
+/*******************************************************************************/
+ReturnCode ST25R200Transport::xferData(const uint8_t *txData, uint8_t *rxData, uint16_t length)
+{
+  NO_WARNING(txData);
+  NO_WARNING(rxData);
+  NO_WARNING(length);
+
+  return ERR_NOTSUPP;
+}
+
+
+/*******************************************************************************/
+void ST25R200Transport::xferEnd(void)
+{
+}
+
+
+/*
+******************************************************************************
+* ST25R200MockTransport
+******************************************************************************
+*/
+
+/*******************************************************************************/
+ST25R200MockTransport::ST25R200MockTransport(void)
+{
+  ST_MEMSET(testRegs, 0x00, sizeof(testRegs));
+  ST_MEMSET(fifo, 0x00, sizeof(fifo));
+  reset();
+}
+
+
+/*******************************************************************************/
+void ST25R200MockTransport::setRegister(uint8_t reg, uint8_t val)
+{
+  if (reg <= ST25R200_REG_IC_ID) {
+    regs[reg] = val;
+  }
+}
+
+
+/*******************************************************************************/
+uint8_t ST25R200MockTransport::getRegister(uint8_t reg) const
+{
+  return ((reg <= ST25R200_REG_IC_ID) ? regs[reg] : 0U);
+}
+
+
+/*******************************************************************************/
+void ST25R200MockTransport::setTestRegister(uint8_t reg, uint8_t val)
+{
+  if (reg <= ST25R200_REG_IC_ID) {
+    testRegs[reg] = val;
+  }
+}
+
+
+/*******************************************************************************/
+uint8_t ST25R200MockTransport::getTestRegister(uint8_t reg) const
+{
+  return ((reg <= ST25R200_REG_IC_ID) ? testRegs[reg] : 0U);
+}
+
+
+/*******************************************************************************/
+uint16_t ST25R200MockTransport::fifoLoad(const uint8_t *data, uint16_t length)
+{
+  uint16_t len;
+
+  len = (uint16_t)MIN(length, (uint16_t)(ST25R200_FIFO_DEPTH - fifoLen));
+  if ((data != NULL) && (len > 0U)) {
+    ST_MEMCPY(&fifo[fifoLen], data, len);
+    fifoLen += len;
+  }
+
+  fifoStatusUpdate();
+  return len;
+}
+
+
+/*******************************************************************************/
+uint16_t ST25R200MockTransport::fifoFetch(uint8_t *data, uint16_t length)
+{
+  uint16_t len;
+
+  len = MIN(length, fifoLen);
+  if (data != NULL) {
+    ST_MEMCPY(data, fifo, len);
+  }
+
+  fifoLen -= len;
+  ST_MEMMOVE(fifo, &fifo[len], fifoLen);
+
+  fifoStatusUpdate();
+  return len;
+}
+
+
+/*******************************************************************************/
+uint8_t ST25R200MockTransport::getLastCommand(void) const
+{
+  return lastCmd;
+}
+
+
+/*******************************************************************************/
+ReturnCode ST25R200MockTransport::xfer(const uint8_t *hdr, uint8_t hdrLen, const uint8_t *txData, uint8_t *rxData, uint16_t length)
+{
+  uint8_t  reg;
+  uint16_t i;
+  uint8_t  dummy[1];
+
+  if ((hdr == NULL) || (hdrLen == 0U)) {
+    return ERR_PARAM;
+  }
+
+  /* Test register access */
+  if ((hdrLen == 2U) && (hdr[0] == ST25R200_CMD_TEST_ACCESS)) {
+    reg = (hdr[1] & ST25R200_ADDR_MASK);
+    for (i = 0; (i < length) && ((reg + i) <= ST25R200_REG_IC_ID); i++) {
+      if (txData != NULL) {
+        testRegs[reg + i] = txData[i];
+      } else if (rxData != NULL) {
+        rxData[i] = testRegs[reg + i];
+      } else {
+        /* MISRA 15.7 - Empty else */
+      }
+    }
+    return ERR_NONE;
+  }
+
+  /* Direct command */
+  if ((hdr[0] & ST25R200_CMD_MASK) == ST25R200_CMD_MASK) {
+    lastCmd = hdr[0];
+
+    if (lastCmd == ST25R200_CMD_SET_DEFAULT) {
+      reset();
+    } else if ((lastCmd == ST25R200_CMD_STOP) || (lastCmd == ST25R200_CMD_CLEAR_FIFO)) {
+      fifoLen = 0U;
+      fifoStatusUpdate();
+    } else {
+      /* MISRA 15.7 - Empty else */
+    }
+    return ERR_NONE;
+  }
+
+  reg = (hdr[0] & ST25R200_ADDR_MASK);
+
+  /* FIFO access */
+  if (reg == ST25R200_FIFO_ACCESS) {
+    if (txData != NULL) {
+      fifoLoad(txData, length);
+    } else {
+      for (i = 0; i < length; i++) {
+        if (fifoFetch(((rxData != NULL) ? &rxData[i] : dummy), 1U) == 0U) {
+          regs[ST25R200_REG_FIFO_STATUS2] |= ST25R200_REG_FIFO_STATUS2_fifo_unf;
+        }
+      }
+    }
+    return ERR_NONE;
+  }
+
+  if (reg > ST25R200_REG_IC_ID) {
+    return ERR_PARAM;
+  }
+
+  /* Register access with auto-increment, IC identity is read only */
+  for (i = 0; (i < length) && ((reg + i) <= ST25R200_REG_IC_ID); i++) {
+    if (txData != NULL) {
+      if ((reg + i) != ST25R200_REG_IC_ID) {
+        regs[reg + i] = txData[i];
+      }
+    } else if (rxData != NULL) {
+      rxData[i] = regs[reg + i];
+    } else {
+      /* MISRA 15.7 - Empty else */
+    }
+  }
+
+  return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+void ST25R200MockTransport::reset(void)
+{
+  ST_MEMSET(regs, 0x00, sizeof(regs));
+  regs[ST25R200_REG_IC_ID] = (ST25R200_REG_IC_ID_ic_type_st25r200 | ST25R200_REG_IC_ID_ic_rev1);
+
+  fifoLen = 0U;
+  lastCmd = 0U;
+  fifoStatusUpdate();
+}
+
+
+/*******************************************************************************/
+void ST25R200MockTransport::fifoStatusUpdate(void)
+{
+  regs[ST25R200_REG_FIFO_STATUS1]  = (uint8_t)(fifoLen & 0xFFU);
+  regs[ST25R200_REG_FIFO_STATUS2] &= (uint8_t)~ST25R200_REG_FIFO_STATUS2_fifo_b8;
+  regs[ST25R200_REG_FIFO_STATUS2] |= (uint8_t)((fifoLen >> 8U) << ST25R200_REG_FIFO_STATUS2_fifo_b_shift);
+}
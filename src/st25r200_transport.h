@@ -0,0 +1,197 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief ST25R200 bus transport
+ *
+ *  Bus access used by the ST25R200 communication layer.
+ *  Every access to the chip is a single bus transaction made of a header
+ *  (direct command, register/FIFO address, test access prefix) followed by
+ *  an optional data phase, so a backend is free to merge both phases.
+ *
+ *  This header has no Arduino dependency, it provides the interface and:
+ *   - Mock : in-process register file and FIFO, no hardware required
+ *
+ *  The SPI and I2C backends are provided by st25r200_transport_arduino.h
+ *
+ */
+
+#ifndef ST25R200_TRANSPORT_H
+#define ST25R200_TRANSPORT_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "st25r200_config.h"
+#include "st_errno.h"
+#include "st25r200.h"
+#include "st25r200_com.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+
+#define ST25R200_TRANSPORT_HDR_MAX     2U                             /*!< Max header length: test access command plus address           */
+#define ST25R200_ADDR_MASK             0x7FU                          /*!< Register/FIFO address bits of the header byte                 */
+#define ST25R200_CMD_MASK              0x60U                          /*!< Header bits set on direct commands                            */
+
+/*
+******************************************************************************
+* GLOBAL TYPES
+******************************************************************************
+*/
+
+/*! Byte counters of a bus transport                                                              */
+typedef struct {
+  uint32_t                transactions;/*!< Number of bus transactions                           */
+  uint32_t                bytesTx;     /*!< Bytes sent, header included                          */
+  uint32_t                bytesRx;     /*!< Bytes received                                       */
+  uint16_t                lastTx;      /*!< Bytes sent by the last transaction, header included  */
+  uint16_t                lastRx;      /*!< Bytes received by the last transaction               */
+} st25r200TransportStats;
+
+
+/*! Bus transport interface of the ST25R200 communication layer
+ *
+ *  A transaction is started by a header and followed by a data phase which
+ *  is either written (txData != NULL) or read (txData == NULL, rxData may
+ *  be NULL to discard the bytes read).
+ *  Backends implement xfer(), and optionally xferStart()/xferData()/xferEnd()
+ *  when a transaction can be left open for a data phase performed elsewhere.
+ */
+class ST25R200Transport {
+  public:
+    ST25R200Transport(void);
+    virtual ~ST25R200Transport() {}
+
+    /*! Configure the bus pins, called once by rfalInitialize() */
+    virtual void begin(void) {}
+
+    /*! Acquire and configure the bus for a sequence of transactions, calls can be nested */
+    virtual void lock(void) {}
+
+    /*! Release the bus acquired with lock() */
+    virtual void unlock(void) {}
+
+    /*!
+    *****************************************************************************
+    *  \brief  Perform a bus transaction
+    *
+    *  \param[in]  hdr    : header bytes (command, address)
+    *  \param[in]  hdrLen : number of header bytes
+    *  \param[in]  txData : data to be written, NULL on reads
+    *  \param[out] rxData : buffer for the data read, NULL to discard
+    *  \param[in]  length : length of the data phase
+    *
+    *  \return ERR_NONE  : Operation successful
+    *  \return ERR_SEND  : Transmission error or acknowledge not received
+    *****************************************************************************
+    */
+    ReturnCode transfer(const uint8_t *hdr, uint8_t hdrLen, const uint8_t *txData, uint8_t *rxData, uint16_t length);
+
+    /*!
+    *****************************************************************************
+    *  \brief  Start a transaction whose data phase is performed separately
+    *
+    *  Sends the header and leaves the transaction open.
+    *
+    *  \return true  : transaction open, to be completed by transferEnd()
+    *  \return false : not supported by the backend, nothing has been sent
+    *****************************************************************************
+    */
+    bool transferStart(const uint8_t *hdr, uint8_t hdrLen);
+
+    /*! Perform (part of) the data phase of a transaction opened by transferStart() */
+    ReturnCode transferData(const uint8_t *txData, uint8_t *rxData, uint16_t length);
+
+    /*! Close a transaction opened by transferStart() */
+    void transferEnd(void);
+
+    /*! Account data bytes moved outside of the transport, e.g. by a DMA transfer hook */
+    void account(uint16_t txBytes, uint16_t rxBytes);
+
+    /*! Retrieve the byte counters */
+    void getStats(st25r200TransportStats *st) const;
+
+    /*! Reset the byte counters */
+    void resetStats(void);
+
+  protected:
+    virtual ReturnCode xfer(const uint8_t *hdr, uint8_t hdrLen, const uint8_t *txData, uint8_t *rxData, uint16_t length);
+    virtual bool xferStart(const uint8_t *hdr, uint8_t hdrLen);
+    virtual ReturnCode xferData(const uint8_t *txData, uint8_t *rxData, uint16_t length);
+    virtual void xferEnd(void);
+
+    st25r200TransportStats stats;      /*!< Byte counters */
+};
+
+
+/*! ST25R200 mock transport
+ *
+ *  Emulates the register file, the test registers and the FIFO of an
+ *  ST25R200 in memory, so that the communication layer can be run and
+ *  measured without the chip (e.g. on a host).
+ *  The FIFO is shared between both directions as on the chip: bytes
+ *  written by the driver can be fetched with fifoFetch(), bytes to be
+ *  read by the driver are provided with fifoLoad().
+ */
+class ST25R200MockTransport : public ST25R200Transport {
+  public:
+    ST25R200MockTransport(void);
+
+    void setRegister(uint8_t reg, uint8_t val);
+    uint8_t getRegister(uint8_t reg) const;
+    void setTestRegister(uint8_t reg, uint8_t val);
+    uint8_t getTestRegister(uint8_t reg) const;
+    uint16_t fifoLoad(const uint8_t *data, uint16_t length);
+    uint16_t fifoFetch(uint8_t *data, uint16_t length);
+    uint8_t getLastCommand(void) const;
+
+  protected:
+    ReturnCode xfer(const uint8_t *hdr, uint8_t hdrLen, const uint8_t *txData, uint8_t *rxData, uint16_t length);
+    void reset(void);
+    void fifoStatusUpdate(void);
+
+    uint8_t  regs[ST25R200_REG_IC_ID + 1U];    /*!< Register file                          */
+    uint8_t  testRegs[ST25R200_REG_IC_ID + 1U];/*!< Test registers                         */
+    uint8_t  fifo[ST25R200_FIFO_DEPTH];        /*!< FIFO content                           */
+    uint16_t fifoLen;                          /*!< Number of bytes in the FIFO            */
+    uint8_t  lastCmd;                          /*!< Last direct command executed           */
+};
+
+#endif /* ST25R200_TRANSPORT_H */
+
+/**
+  * @}
+  *
+  * @}
+  *
+  * @}
+  *
+  * @}
+  */
@@ -0,0 +1,223 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief Implementation of the ST25R200 SPI and I2C bus transports.
+ *
+ */
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "st25r200_transport_arduino.h"
+#include "nfc_utils.h"
+
+/*
+******************************************************************************
+* LOCAL DEFINES
+******************************************************************************
+*/
+
+#if defined(STM32_CORE_VERSION) && (STM32_CORE_VERSION >= 0x02080000)
+#define ST25R200_SPI_TX_CONST          true                           /*!< SPIClass transmits from a const buffer, RX data not stored    */
+#else
+#define ST25R200_SPI_TX_CONST          false                          /*!< SPIClass overwrites the TX buffer with the RX data            */
+#endif
+#define ST25R200_SPI_SCRATCH_LEN       32U                            /*!< Scratch buffer length on SPIClass overwriting the TX buffer   */
+
+/*
+******************************************************************************
+* ST25R200SpiTransport
+******************************************************************************
+*/
+
+/*******************************************************************************/
+ST25R200SpiTransport::ST25R200SpiTransport(SPIClass *spi, int cs_pin, uint32_t spi_speed) : dev_spi(spi), cs_pin(cs_pin), spi_speed(spi_speed)
+{
+  lockCnt = 0U;
+}
+
+
+/*******************************************************************************/
+void ST25R200SpiTransport::begin(void)
+{
+  pinMode(cs_pin, OUTPUT);
+  digitalWrite(cs_pin, HIGH);
+}
+
+
+/*******************************************************************************/
+void ST25R200SpiTransport::lock(void)
+{
+  if (lockCnt == 0U) {
+    /* Setting Transaction Parameters */
+    dev_spi->beginTransaction(SPISettings(spi_speed, MSBFIRST, SPI_MODE1));
+  }
+  lockCnt++;
+}
+
+
+/*******************************************************************************/
+void ST25R200SpiTransport::unlock(void)
+{
+  if (lockCnt == 0U) {
+    return;
+  }
+
+  lockCnt--;
+  if (lockCnt == 0U) {
+    dev_spi->endTransaction();
+  }
+}
+
+
+/*******************************************************************************/
+bool ST25R200SpiTransport::xferStart(const uint8_t *hdr, uint8_t hdrLen)
+{
+  uint8_t i;
+
+  lock();
+  digitalWrite(cs_pin, LOW);
+
+  for (i = 0; i < hdrLen; i++) {
+    dev_spi->transfer(hdr[i]);
+  }
+
+  return true;
+}
+
+
+/*******************************************************************************/
+ReturnCode ST25R200SpiTransport::xferData(const uint8_t *txData, uint8_t *rxData, uint16_t length)
+{
+  uint16_t i;
+
+  if (txData == NULL) {
+    if (rxData != NULL) {
+      dev_spi->transfer((void *)rxData, length);
+    } else {
+      for (i = 0; i < length; i++) {
+        dev_spi->transfer(0x00U);
+      }
+    }
+    return ERR_NONE;
+  }
+
+#if ST25R200_SPI_TX_CONST
+  /* Send straight from the caller's buffer */
+  dev_spi->transfer(txData, NULL, length);
+#else
+  uint8_t  scratch[ST25R200_SPI_SCRATCH_LEN];
+  uint16_t len;
+
+  /* The received data overwrites the buffer transmitted, keep the caller's buffer untouched */
+  for (i = 0; i < length; i += len) {
+    len = (uint16_t)MIN((uint16_t)(length - i), ST25R200_SPI_SCRATCH_LEN);
+    ST_MEMCPY(scratch, &txData[i], len);
+    dev_spi->transfer((void *)scratch, len);
+  }
+#endif /* ST25R200_SPI_TX_CONST */
+
+  return ERR_NONE;
+}
+
+
+/*******************************************************************************/
+void ST25R200SpiTransport::xferEnd(void)
+{
+  digitalWrite(cs_pin, HIGH);
+  unlock();
+}
+
+
+/*
+******************************************************************************
+* ST25R200I2cTransport
+******************************************************************************
+*/
+
+/*******************************************************************************/
+ST25R200I2cTransport::ST25R200I2cTransport(TwoWire *i2c, uint8_t i2c_addr) : dev_i2c(i2c), i2c_addr(i2c_addr)
+{
+}
+
+
+/*******************************************************************************/
+ReturnCode ST25R200I2cTransport::xfer(const uint8_t *hdr, uint8_t hdrLen, const uint8_t *txData, uint8_t *rxData, uint16_t length)
+{
+  uint8_t  addr[ST25R200_TRANSPORT_HDR_MAX];
+  uint16_t i;
+  uint16_t len;
+  uint16_t n;
+  uint8_t  rdVal;
+  bool     isReg;
+
+  if ((hdrLen == 0U) || (hdrLen > ST25R200_TRANSPORT_HDR_MAX)) {
+    return ERR_PARAM;
+  }
+
+  /* Writes and commands: header and data within a single write */
+  if ((txData != NULL) || (length == 0U)) {
+    dev_i2c->beginTransmission(i2c_addr);
+    dev_i2c->write(hdr, hdrLen);
+    if (length > 0U) {
+      dev_i2c->write(txData, length);
+    }
+    return ((dev_i2c->endTransmission(true) == 0U) ? ERR_NONE : ERR_SEND);
+  }
+
+  /* Reads: address phase, repeated start, data phase. Long reads are split in chunks;
+   * the FIFO keeps delivering its content, register reads are re-addressed           */
+  ST_MEMCPY(addr, hdr, hdrLen);
+  isReg = ((hdr[hdrLen - 1U] & ST25R200_ADDR_MASK) < ST25R200_FIFO_ACCESS);
+
+  for (i = 0; i < length; i += len) {
+    len = (uint16_t)MIN((uint16_t)(length - i), ST25R200_I2C_CHUNK_LEN);
+
+    if ((i == 0U) || isReg) {
+      addr[hdrLen - 1U] = (uint8_t)(hdr[hdrLen - 1U] + (isReg ? i : 0U));
+
+      dev_i2c->beginTransmission(i2c_addr);
+      dev_i2c->write(addr, hdrLen);
+      if (dev_i2c->endTransmission(false) != 0U) {
+        return ERR_SEND;
+      }
+    }
+
+    if (dev_i2c->requestFrom(i2c_addr, (uint8_t)len, (uint8_t)(((i + len) >= length) ? 1U : 0U)) != len) {
+      return ERR_SEND;
+    }
+
+    for (n = 0; n < len; n++) {
+      rdVal = (uint8_t)dev_i2c->read();
+      if (rxData != NULL) {
+        rxData[i + n] = rdVal;
+      }
+    }
+  }
+
+  return ERR_NONE;
+}
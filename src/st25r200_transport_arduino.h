@@ -0,0 +1,105 @@
+/******************************************************************************
+  * \attention
+  *
+  * <h2><center>&copy; COPYRIGHT 2021 STMicroelectronics</center></h2>
+  *
+  * Licensed under ST MIX MYLIBERTY SOFTWARE LICENSE AGREEMENT (the "License");
+  * You may not use this file except in compliance with the License.
+  * You may obtain a copy of the License at:
+  *
+  *        www.st.com/mix_myliberty
+  *
+  * Unless required by applicable law or agreed to in writing, software
+  * distributed under the License is distributed on an "AS IS" BASIS,
+  * WITHOUT WARRANTIES OR CONDITIONS OF ANY KIND, either express or implied,
+  * AND SPECIFICALLY DISCLAIMING THE IMPLIED WARRANTIES OF MERCHANTABILITY,
+  * FITNESS FOR A PARTICULAR PURPOSE, AND NON-INFRINGEMENT.
+  * See the License for the specific language governing permissions and
+  * limitations under the License.
+  *
+******************************************************************************/
+
+/*! \file
+ *
+ *  \author SRA
+ *
+ *  \brief ST25R200 Arduino bus transports
+ *
+ *  Backends of the ST25R200 bus transport on the Arduino bus classes:
+ *   - SPI  : the ST25R200 SPI interface (default)
+ *   - I2C  : burst reads using a repeated start after the address phase
+ *
+ */
+
+#ifndef ST25R200_TRANSPORT_ARDUINO_H
+#define ST25R200_TRANSPORT_ARDUINO_H
+
+/*
+******************************************************************************
+* INCLUDES
+******************************************************************************
+*/
+#include "Arduino.h"
+#include "SPI.h"
+#include "Wire.h"
+#include "st25r200_transport.h"
+
+/*
+******************************************************************************
+* GLOBAL DEFINES
+******************************************************************************
+*/
+
+#define ST25R200_I2C_ADDR              (0xA0U >> 1)                   /*!< ST25R200's default I2C address                                */
+#define ST25R200_I2C_CHUNK_LEN         32U                            /*!< Max bytes read per I2C read request                           */
+
+/*
+******************************************************************************
+* GLOBAL TYPES
+******************************************************************************
+*/
+
+/*! ST25R200 SPI transport                                                                        */
+class ST25R200SpiTransport : public ST25R200Transport {
+  public:
+    ST25R200SpiTransport(SPIClass *spi, int cs_pin, uint32_t spi_speed = 5000000);
+
+    void begin(void);
+    void lock(void);
+    void unlock(void);
+
+  protected:
+    bool xferStart(const uint8_t *hdr, uint8_t hdrLen);
+    ReturnCode xferData(const uint8_t *txData, uint8_t *rxData, uint16_t length);
+    void xferEnd(void);
+
+    SPIClass *dev_spi;
+    int cs_pin;
+    uint32_t spi_speed;
+    uint8_t lockCnt;                   /*!< Nesting level of lock() */
+};
+
+
+/*! ST25R200 I2C transport                                                                        */
+class ST25R200I2cTransport : public ST25R200Transport {
+  public:
+    ST25R200I2cTransport(TwoWire *i2c, uint8_t i2c_addr = ST25R200_I2C_ADDR);
+
+  protected:
+    ReturnCode xfer(const uint8_t *hdr, uint8_t hdrLen, const uint8_t *txData, uint8_t *rxData, uint16_t length);
+
+    TwoWire *dev_i2c;
+    uint8_t i2c_addr;
+};
+
+#endif /* ST25R200_TRANSPORT_ARDUINO_H */
+
+/**
+  * @}
+  *
+  * @}
+  *
+  * @}
+  *
+  * @}
+  */